@@ -0,0 +1,110 @@
+/// @brief Replaces the global allocation functions so that the benchmarks can
+/// count heap allocations.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "benchmark.hpp"
+
+namespace {
+
+/// @brief The number of allocations made so far.
+std::atomic<std::uint64_t> allocations{0};
+/// @brief The number of bytes requested so far.
+std::atomic<std::uint64_t> bytes{0};
+
+/// @brief Records one allocation and hands it to `malloc` or `aligned_alloc`.
+void* allocate(std::size_t size, std::size_t alignment) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  bytes.fetch_add(size, std::memory_order_relaxed);
+
+  if (size == 0) {
+    size = 1;
+  }
+
+  if (alignment <= alignof(std::max_align_t)) {
+    return std::malloc(size);
+  }
+
+  const std::size_t rounded = (size + alignment - 1) & ~(alignment - 1);
+
+  return std::aligned_alloc(alignment, rounded);
+}
+
+/// @brief Allocates like `allocate`, throwing `bad_alloc` on failure.
+void* allocateOrThrow(std::size_t size, std::size_t alignment) {
+  void* pointer = allocate(size, alignment);
+
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return pointer;
+}
+
+}  // namespace
+
+namespace bench {
+
+std::uint64_t allocationCount() {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+std::uint64_t allocatedBytes() { return bytes.load(std::memory_order_relaxed); }
+
+}  // namespace bench
+
+void* operator new(std::size_t size) {
+  return allocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size) {
+  return allocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size, alignof(std::max_align_t));
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
@@ -0,0 +1,651 @@
+/// @brief Shared pieces of the benchmark suite: seeded workload generators, a
+/// sampling runner and its JSON report.
+///
+/// Every benchmark program includes exactly one solution file followed by this
+/// header, and links `benchmark.cpp`, which counts heap allocations.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace bench {
+
+/// @brief The number of `operator new` calls made so far by the process.
+std::uint64_t allocationCount();
+
+/// @brief The number of bytes requested from `operator new` so far.
+std::uint64_t allocatedBytes();
+
+/// @brief Returns the peak resident set size of the process, in kilobytes.
+inline long peakRssKilobytes() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+
+  return usage.ru_maxrss;
+}
+
+/// @brief Reads one kilobyte field, such as `VmRSS` or `VmHWM`, from
+/// `/proc/self/status`.
+/// @return The value, or -1 when the field cannot be read.
+inline long procStatusKilobytes(std::string_view field) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+
+  while (std::getline(status, line)) {
+    if (line.starts_with(field) && line.size() > field.size() &&
+        line[field.size()] == ':') {
+      return std::atol(line.c_str() + field.size() + 1);
+    }
+  }
+
+  return -1;
+}
+
+/// @brief Starts a new window for measuring RSS growth.
+///
+/// Returns the free heap memory to the kernel where the allocator allows it,
+/// then resets the high-water mark of the resident set to its current size
+/// through `/proc/self/clear_refs`.
+///
+/// @return Whether the high-water mark was reset, so that `VmHWM` covers the
+/// new window only.
+inline bool resetPeakRss() {
+#ifdef __GLIBC__
+  malloc_trim(0);
+#endif
+
+  std::ofstream clearRefs("/proc/self/clear_refs");
+  clearRefs << "5";
+  clearRefs.close();
+
+  return static_cast<bool>(clearRefs) && procStatusKilobytes("VmHWM") >= 0;
+}
+
+/// @brief Keeps the compiler from optimizing away `value` or the work that
+/// produced it.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// @class Rng
+/// @brief A small, fast and seedable SplitMix64 generator, so that every
+/// workload can be reproduced from its seed alone.
+class Rng {
+ public:
+  explicit Rng(std::uint64_t seed) : state(seed) {}
+
+  /// @brief Returns the next 64 random bits.
+  std::uint64_t next() {
+    std::uint64_t z = (this->state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+    return z ^ (z >> 31);
+  }
+
+  /// @brief Returns a number in `[0, bound)`.
+  int below(int bound) {
+    return static_cast<int>(((this->next() >> 32) * bound) >> 32);
+  }
+
+  /// @brief Returns a number in `[0, 1)`.
+  double unit() { return (this->next() >> 11) * 0x1.0p-53; }
+
+ private:
+  std::uint64_t state;
+};
+
+/// @brief An edge list in the packed layout the solutions accept.
+using EdgeList = std::vector<std::array<int, 2>>;
+
+/// @brief Relabels every node of `edges` with a random permutation, so that
+/// node labels carry no locality.
+inline void shuffleLabels(int n, EdgeList& edges, Rng& rng) {
+  std::vector<int> labels(n);
+  std::iota(labels.begin(), labels.end(), 0);
+
+  for (int i = n - 1; i > 0; i--) {
+    std::swap(labels[i], labels[rng.below(i + 1)]);
+  }
+
+  for (std::array<int, 2>& edge : edges) {
+    edge = {labels[edge[0]], labels[edge[1]]};
+  }
+}
+
+/// @brief Generates a Graph500-style R-MAT graph: skewed degrees, a giant
+/// component and a long tail of small ones.
+/// @param scale The graph has `2^scale` nodes.
+/// @param edgeFactor The number of edges per node.
+/// @param rng The source of randomness.
+/// @return The undirected edges, without self-loops.
+inline EdgeList rmatEdges(int scale, int edgeFactor, Rng& rng) {
+  constexpr double a = 0.57, b = 0.19, c = 0.19;
+  const int n = 1 << scale;
+  const std::size_t count = static_cast<std::size_t>(n) * edgeFactor;
+  EdgeList edges;
+
+  edges.reserve(count);
+
+  while (edges.size() < count) {
+    int u = 0, v = 0;
+
+    for (int bit = 0; bit < scale; bit++) {
+      const double roll = rng.unit();
+      u |= (roll >= a + b) << bit;
+      v |= ((roll >= a && roll < a + b) || roll >= a + b + c) << bit;
+    }
+
+    if (u != v) {
+      edges.push_back({u, v});
+    }
+  }
+
+  shuffleLabels(n, edges, rng);
+
+  return edges;
+}
+
+/// @brief Generates a `rows` x `cols` grid where every cell is joined to its
+/// right and lower neighbors: a large diameter and a uniform degree.
+inline EdgeList gridEdges(int rows, int cols) {
+  EdgeList edges;
+
+  edges.reserve(2 * static_cast<std::size_t>(rows) * cols);
+
+  for (int row = 0; row < rows; row++) {
+    for (int col = 0; col < cols; col++) {
+      const int cell = row * cols + col;
+
+      if (col + 1 < cols) {
+        edges.push_back({cell, cell + 1});
+      }
+
+      if (row + 1 < rows) {
+        edges.push_back({cell, cell + cols});
+      }
+    }
+  }
+
+  return edges;
+}
+
+/// @brief Generates a star over nodes `1..n` with the given center, with the
+/// edges in random order and random orientation.
+inline EdgeList starEdges(int n, int center, Rng& rng) {
+  EdgeList edges;
+
+  edges.reserve(n - 1);
+
+  for (int node = 1; node <= n; node++) {
+    if (node != center) {
+      edges.push_back(rng.below(2) ? std::array{node, center}
+                                   : std::array{center, node});
+    }
+  }
+
+  for (std::size_t i = edges.size() - 1; i > 0; i--) {
+    std::swap(edges[i], edges[rng.below(static_cast<int>(i + 1))]);
+  }
+
+  return edges;
+}
+
+/// @brief Generates trust pairs over people `1..n`, each ordered pair present
+/// with probability `density`, plus a Judge if asked for.
+/// @param n The number of people.
+/// @param density The probability of each pair.
+/// @param judge The label of the Judge, or 0 for none.
+/// @param rng The source of randomness.
+/// @return The `[a, b]` pairs, each at most once.
+inline EdgeList trustEdges(int n, double density, int judge, Rng& rng) {
+  EdgeList edges;
+
+  edges.reserve(static_cast<std::size_t>(density * n * n) + n);
+
+  for (int a = 1; a <= n; a++) {
+    for (int b = 1; b <= n; b++) {
+      if (a == b || a == judge) {
+        continue;
+      }
+
+      if (b == judge || rng.unit() < density) {
+        edges.push_back({a, b});
+      }
+    }
+  }
+
+  return edges;
+}
+
+/// @brief Generates `count` random `(source, destination)` pairs over `n`
+/// nodes.
+inline std::vector<std::pair<int, int>> randomQueries(int n, int count,
+                                                      Rng& rng) {
+  std::vector<std::pair<int, int>> queries(count);
+
+  for (std::pair<int, int>& query : queries) {
+    query = {rng.below(n), rng.below(n)};
+  }
+
+  return queries;
+}
+
+/// @brief Copies packed edges into the `vector<vector<int>>` layout of the
+/// original LeetCode signatures.
+inline std::vector<std::vector<int>> toNested(const EdgeList& edges) {
+  std::vector<std::vector<int>> nested;
+
+  nested.reserve(edges.size());
+
+  for (const std::array<int, 2>& edge : edges) {
+    nested.push_back({edge[0], edge[1]});
+  }
+
+  return nested;
+}
+
+/// @class Runner
+/// @brief Times benchmark bodies, prints one line per benchmark and writes
+/// every result to a JSON report.
+///
+/// Each benchmark runs once to warm up and calibrate, then is sampled a fixed
+/// number of times; a sample repeats the body enough times to last at least
+/// `minSampleTime`. Latencies are per call of the body.
+///
+/// The RSS column is how far the resident set grew above its size before the
+/// benchmark, at its peak when the kernel can reset the high-water mark and at
+/// the end otherwise. Memory an earlier benchmark freed but the allocator kept
+/// can be reused without showing up here.
+///
+/// Command-line options:
+/// - `--quick` shrinks every workload, for smoke runs.
+/// - `--samples=N` sets the number of samples (default 15).
+/// - `--seed=N` changes the seed of every generator (default 42).
+/// - `--filter=TEXT` only runs the benchmarks whose name contains `TEXT`.
+/// - `--json=PATH` writes the report to `PATH`.
+/// - `--threads=N,M,...` sets the thread counts of the scaling sweeps
+///   (default: the powers of two up to the hardware concurrency, and the
+///   hardware concurrency itself).
+/// - `--NAME=N` sets an integer option the benchmark program declared.
+class Runner {
+ public:
+  /// @brief Parses the command line of the benchmark program.
+  /// @param suite The name of the suite, usually the solution file.
+  /// @param options The names of the integer options the program reads
+  /// through `option`; any other unknown option is an error.
+  Runner(std::string suite, int argc, char** argv,
+         std::initializer_list<std::string_view> options = {})
+      : suite(std::move(suite)) {
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned threads = 1; threads < hardware; threads *= 2) {
+      this->threads.push_back(threads);
+    }
+
+    this->threads.push_back(hardware);
+
+    for (int i = 1; i < argc; i++) {
+      const std::string_view arg = argv[i];
+      const std::string_view name = arg.substr(0, arg.find('='));
+
+      if (arg == "--quick") {
+        this->isQuick = true;
+      } else if (arg.starts_with("--samples=")) {
+        this->samples = std::max(1, std::atoi(arg.data() + 10));
+      } else if (arg.starts_with("--seed=")) {
+        this->baseSeed = std::strtoull(arg.data() + 7, nullptr, 10);
+      } else if (arg.starts_with("--filter=")) {
+        this->filter = arg.substr(9);
+      } else if (arg.starts_with("--json=")) {
+        this->jsonPath = arg.substr(7);
+      } else if (arg.starts_with("--threads=")) {
+        this->threads.clear();
+
+        for (const char* next = arg.data() + 10; *next != '\0';) {
+          char* end = nullptr;
+          const unsigned long count = std::strtoul(next, &end, 10);
+
+          if (end == next || (*end != ',' && *end != '\0')) {
+            std::cerr << "bad thread counts in " << arg << '\n';
+            std::exit(2);
+          }
+
+          this->threads.push_back(std::max(1ul, count));
+          next = *end == ',' ? end + 1 : end;
+        }
+
+        if (this->threads.empty()) {
+          std::cerr << "no thread counts in " << arg << '\n';
+          std::exit(2);
+        }
+      } else if (name.size() > 2 && arg.size() > name.size() &&
+                 std::find(options.begin(), options.end(), name.substr(2)) !=
+                     options.end()) {
+        this->options[std::string(name.substr(2))] =
+            std::atoll(arg.data() + name.size() + 1);
+      } else {
+        std::cerr << "unknown option " << arg << '\n';
+        std::exit(2);
+      }
+    }
+  }
+
+  /// @brief Returns the seed every generator should start from.
+  std::uint64_t seed() const { return this->baseSeed; }
+
+  /// @brief Returns `full`, or `quick` when the run was asked to be quick.
+  template <typename T>
+  T pick(T full, T quick) const {
+    return this->isQuick ? quick : full;
+  }
+
+  /// @brief Returns the thread counts the scaling sweeps should cover.
+  const std::vector<unsigned>& threadCounts() const { return this->threads; }
+
+  /// @brief Returns the value of the integer option `--NAME=N`, or `fallback`
+  /// when it was not given. `name` must be one of the options passed to the
+  /// constructor.
+  long long option(const std::string& name, long long fallback) const {
+    const auto found = this->options.find(name);
+    return found != this->options.end() ? found->second : fallback;
+  }
+
+  /// @brief Runs and records one benchmark.
+  /// @tparam Body A callable taking no arguments.
+  /// @param name The name of the benchmark.
+  /// @param itemsPerCall How many items, such as edges or numbers, one call
+  /// of `body` processes; used for the throughput.
+  /// @param body The code to measure.
+  template <typename Body>
+  void run(const std::string& name, double itemsPerCall, Body&& body) {
+    if (name.find(this->filter) == std::string::npos) {
+      return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    const bool peakReset = resetPeakRss();
+    const long rssBefore = procStatusKilobytes("VmRSS");
+    const Clock::time_point warmStart = Clock::now();
+    body();
+    const double warmNs = nanosecondsSince(warmStart);
+    const long calls = std::max<long>(1, minSampleTime / std::max(warmNs, 1.0));
+
+    std::vector<double> latencies;
+    latencies.reserve(this->samples);
+
+    const std::uint64_t allocationsBefore = allocationCount();
+    const std::uint64_t bytesBefore = allocatedBytes();
+
+    for (int sample = 0; sample < this->samples; sample++) {
+      const Clock::time_point start = Clock::now();
+
+      for (long call = 0; call < calls; call++) {
+        body();
+      }
+
+      latencies.push_back(nanosecondsSince(start) / calls);
+    }
+
+    const double totalCalls = static_cast<double>(calls) * this->samples;
+    Result result;
+
+    result.name = name;
+    result.callsPerSample = calls;
+    result.itemsPerCall = itemsPerCall;
+    result.allocationsPerCall =
+        (allocationCount() - allocationsBefore) / totalCalls;
+    result.bytesPerCall = (allocatedBytes() - bytesBefore) / totalCalls;
+    result.rssGrowthKb =
+        procStatusKilobytes(peakReset ? "VmHWM" : "VmRSS") - rssBefore;
+    result.rssGrowthIsPeak = peakReset;
+
+    std::sort(latencies.begin(), latencies.end());
+    result.latencies = latencies;
+
+    this->report(result);
+    this->results.push_back(std::move(result));
+  }
+
+  /// @brief Records a benchmark whose body times its own events, such as
+  /// single hand-offs between threads, where the latency of each event
+  /// matters more than the average.
+  ///
+  /// `measure` runs once, after an untimed warm-up run, and returns the
+  /// duration of every event in nanoseconds; the report gives their
+  /// percentiles instead of those of samples. Allocations and RSS growth
+  /// cover the measured run.
+  ///
+  /// @tparam Measure A callable taking no arguments and returning a
+  /// `std::vector<double>`.
+  template <typename Measure>
+  void runEvents(const std::string& name, Measure&& measure) {
+    if (name.find(this->filter) == std::string::npos) {
+      return;
+    }
+
+    measure();
+
+    const bool peakReset = resetPeakRss();
+    const long rssBefore = procStatusKilobytes("VmRSS");
+    const std::uint64_t allocationsBefore = allocationCount();
+    const std::uint64_t bytesBefore = allocatedBytes();
+
+    std::vector<double> latencies = measure();
+
+    const double events = std::max<double>(1, latencies.size());
+    Result result;
+
+    result.name = name;
+    result.callsPerSample = 1;
+    result.itemsPerCall = 1;
+    result.allocationsPerCall =
+        (allocationCount() - allocationsBefore) / events;
+    result.bytesPerCall = (allocatedBytes() - bytesBefore) / events;
+    result.rssGrowthKb =
+        procStatusKilobytes(peakReset ? "VmHWM" : "VmRSS") - rssBefore;
+    result.rssGrowthIsPeak = peakReset;
+
+    if (latencies.empty()) {
+      latencies.push_back(0);
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    result.latencies = std::move(latencies);
+
+    this->report(result);
+    this->results.push_back(std::move(result));
+  }
+
+  /// @brief Attaches a JSON value to a benchmark that ran, under `key`, for
+  /// data only the solution itself can measure.
+  /// @tparam Measure A callable taking no arguments and returning the JSON
+  /// value as a string.
+  /// @param name The name of the benchmark, as passed to `run`.
+  /// @param key The key of the value in the report.
+  /// @param measure The code that measures the value. It is not called when
+  /// the benchmark did not run, e.g. because of `--filter`.
+  template <typename Measure>
+  void attach(const std::string& name, const std::string& key,
+              Measure&& measure) {
+    for (Result& result : this->results) {
+      if (result.name == name) {
+        result.extras.emplace_back(key, measure());
+        return;
+      }
+    }
+  }
+
+  /// @brief Writes the JSON report, if one was asked for.
+  /// @return The exit code of the benchmark program.
+  int finish() const {
+    if (this->jsonPath.empty()) {
+      return 0;
+    }
+
+    std::ofstream out(this->jsonPath);
+    out << this->toJson() << '\n';
+
+    if (!out) {
+      std::cerr << "cannot write " << this->jsonPath << '\n';
+      return 1;
+    }
+
+    return 0;
+  }
+
+ private:
+  /// @brief The measurements of one benchmark.
+  struct Result {
+    std::string name;
+    long callsPerSample = 0;
+    double itemsPerCall = 0;
+    /// @brief The latency of each sample, per call, sorted.
+    std::vector<double> latencies;
+    double allocationsPerCall = 0;
+    double bytesPerCall = 0;
+    /// @brief How far the resident set grew during the benchmark.
+    long rssGrowthKb = 0;
+    /// @brief Whether `rssGrowthKb` is the peak growth or the growth at the
+    /// end.
+    bool rssGrowthIsPeak = false;
+    /// @brief Extra JSON values attached by the benchmark program.
+    std::vector<std::pair<std::string, std::string>> extras;
+
+    /// @brief Returns the given percentile of the sample latencies, in
+    /// nanoseconds.
+    double percentile(double fraction) const {
+      const std::size_t last = this->latencies.size() - 1;
+      return this->latencies[static_cast<std::size_t>(fraction * last + 0.5)];
+    }
+
+    double mean() const {
+      return std::accumulate(this->latencies.begin(), this->latencies.end(),
+                             0.0) /
+             this->latencies.size();
+    }
+
+    double itemsPerSecond() const {
+      return this->itemsPerCall * 1e9 / this->mean();
+    }
+  };
+
+  /// @brief The minimum duration of a sample, in nanoseconds.
+  static constexpr double minSampleTime = 2e6;
+
+  static double nanosecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  }
+
+  /// @brief Prints the result of one benchmark on standard output.
+  void report(const Result& result) const {
+    std::printf(
+        "%-52s p50 %12.0f ns  p99 %12.0f ns  %11.4g items/s  %9.1f allocs  "
+        "%+8ld KB RSS\n",
+        result.name.c_str(), result.percentile(0.5), result.percentile(0.99),
+        result.itemsPerSecond(), result.allocationsPerCall, result.rssGrowthKb);
+    std::fflush(stdout);
+  }
+
+  /// @brief Returns `text` as a JSON string literal.
+  static std::string quote(const std::string& text) {
+    std::string quoted = "\"";
+
+    for (char c : text) {
+      if (c == '"' || c == '\\') {
+        quoted += '\\';
+      }
+
+      quoted += c;
+    }
+
+    return quoted + "\"";
+  }
+
+  /// @brief Returns the whole report as JSON.
+  std::string toJson() const {
+    std::string json = "{\"suite\":" + quote(this->suite) +
+                       ",\"seed\":" + std::to_string(this->baseSeed) +
+                       ",\"quick\":" + (this->isQuick ? "true" : "false") +
+                       ",\"samples\":" + std::to_string(this->samples) +
+                       ",\"peakRssKb\":" + std::to_string(peakRssKilobytes()) +
+                       ",\"benchmarks\":[";
+
+    for (std::size_t i = 0; i < this->results.size(); i++) {
+      const Result& result = this->results[i];
+
+      json += (i == 0 ? "{" : ",{");
+      json += "\"name\":" + quote(result.name);
+      json += ",\"callsPerSample\":" + std::to_string(result.callsPerSample);
+      json += ",\"itemsPerCall\":" + std::to_string(result.itemsPerCall);
+      json += ",\"itemsPerSecond\":" + std::to_string(result.itemsPerSecond());
+      json += ",\"latencyNs\":{\"min\":" + std::to_string(result.latencies[0]) +
+              ",\"p50\":" + std::to_string(result.percentile(0.5)) +
+              ",\"p90\":" + std::to_string(result.percentile(0.9)) +
+              ",\"p99\":" + std::to_string(result.percentile(0.99)) +
+              ",\"max\":" + std::to_string(result.latencies.back()) +
+              ",\"mean\":" + std::to_string(result.mean()) + "}";
+      json += ",\"allocationsPerCall\":" +
+              std::to_string(result.allocationsPerCall);
+      json += ",\"bytesPerCall\":" + std::to_string(result.bytesPerCall);
+      json += ",\"rssGrowthKb\":" + std::to_string(result.rssGrowthKb);
+      json += ",\"rssGrowthIsPeak\":";
+      json += result.rssGrowthIsPeak ? "true" : "false";
+
+      for (const auto& [key, value] : result.extras) {
+        json += "," + quote(key) + ":" + value;
+      }
+
+      json += "}";
+    }
+
+    return json + "]}";
+  }
+
+  /// @brief The name of the suite.
+  std::string suite;
+  /// @brief Whether to run the small workloads.
+  bool isQuick = false;
+  /// @brief The number of samples per benchmark.
+  int samples = 15;
+  /// @brief The seed of every generator.
+  std::uint64_t baseSeed = 42;
+  /// @brief Only benchmarks whose name contains this text are run.
+  std::string filter;
+  /// @brief Where to write the JSON report, or empty for nowhere.
+  std::string jsonPath;
+  /// @brief The thread counts of the scaling sweeps.
+  std::vector<unsigned> threads;
+  /// @brief The integer options given on the command line.
+  std::map<std::string, long long> options;
+  /// @brief The results of every benchmark run so far.
+  std::vector<Result> results;
+};
+
+}  // namespace bench
@@ -0,0 +1,186 @@
+/// @brief Benchmarks the graph cloners on R-MAT and grid graphs.
+
+#include <utility>
+#include <vector>
+
+/// @brief The node type LeetCode provides to the solution.
+class Node {
+ public:
+  int val;
+  std::vector<Node*> neighbors;
+
+  Node() : val(0) {}
+  Node(int val) : val(val) {}
+  Node(int val, std::vector<Node*> neighbors)
+      : val(val), neighbors(std::move(neighbors)) {}
+};
+
+#include "../clone-graph.cpp"
+
+#include "benchmark.hpp"
+
+/// @brief Owns the nodes of an input graph built from an edge list.
+class InputGraph {
+ public:
+  /// @brief Builds `n` nodes labeled `1..n`, dropping repeated edges.
+  InputGraph(int n, bench::EdgeList edges) {
+    for (std::array<int, 2>& edge : edges) {
+      edge = {std::min(edge[0], edge[1]), std::max(edge[0], edge[1])};
+    }
+
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    for (int node = 0; node < n; node++) {
+      this->nodes.push_back(std::make_unique<Node>(node + 1));
+    }
+
+    for (const std::array<int, 2>& edge : edges) {
+      this->nodes[edge[0]]->neighbors.push_back(this->nodes[edge[1]].get());
+      this->nodes[edge[1]]->neighbors.push_back(this->nodes[edge[0]].get());
+    }
+  }
+
+  /// @brief Returns the node with the most neighbors, which sits in the
+  /// largest component of an R-MAT graph.
+  Node* hub() const {
+    return std::max_element(this->nodes.begin(), this->nodes.end(),
+                            [](const auto& left, const auto& right) {
+                              return left->neighbors.size() <
+                                     right->neighbors.size();
+                            })
+        ->get();
+  }
+
+ private:
+  vector<unique_ptr<Node>> nodes;
+};
+
+/// @brief Deletes every node reachable from `head`, as a caller of
+/// `Solution::cloneGraph` has to.
+/// @return The number of nodes deleted.
+size_t deleteGraph(Node* head) {
+  unordered_set<Node*> seen{head};
+  vector<Node*> pending{head};
+
+  while (!pending.empty()) {
+    Node* current = pending.back();
+    pending.pop_back();
+
+    for (Node* neighbor : current->neighbors) {
+      if (seen.insert(neighbor).second) {
+        pending.push_back(neighbor);
+      }
+    }
+  }
+
+  for (Node* node : seen) {
+    delete node;
+  }
+
+  return seen.size();
+}
+
+/// @brief Reads the neighbors of every copy less than `hops` away from the
+/// start of a lazy clone, as a caller exploring its neighborhood would.
+/// @param seen One flag per label, all clear; they are cleared again on
+/// return, so the buffer can be reused without touching every node.
+/// @return The number of copies reached.
+size_t exploreHops(LazyGraphClone& lazy, Node* start, int hops,
+                   vector<char>& seen) {
+  vector<Node*> reached{start};
+  size_t frontier = 0;
+
+  seen[start->val] = 1;
+
+  for (int hop = 0; hop < hops; hop++) {
+    const size_t end = reached.size();
+
+    for (; frontier < end; frontier++) {
+      for (Node* neighbor : lazy.neighborsOf(reached[frontier])) {
+        if (!seen[neighbor->val]) {
+          seen[neighbor->val] = 1;
+          reached.push_back(neighbor);
+        }
+      }
+    }
+  }
+
+  for (Node* copy : reached) {
+    seen[copy->val] = 0;
+  }
+
+  return reached.size();
+}
+
+/// @brief Runs every cloner over one graph. Each call clones the component
+/// of the hub and frees the copy.
+void benchmarkGraph(bench::Runner& runner, const std::string& label, int n,
+                    bench::EdgeList edges) {
+  const InputGraph input(n, std::move(edges));
+  Node* head = input.hub();
+  const double nodes = deleteGraph(Solution().cloneGraph(head));
+
+  runner.run("Solution/" + label, nodes, [&]() {
+    bench::doNotOptimize(deleteGraph(Solution().cloneGraph(head)));
+  });
+
+  ArenaGraphCloner arena;
+
+  runner.run("ArenaGraphCloner/" + label, nodes, [&]() {
+    bench::doNotOptimize(arena.cloneGraph(head));
+    arena.release();
+  });
+
+  for (unsigned threads : runner.threadCounts()) {
+    ParallelGraphCloner parallel(threads);
+
+    runner.run("ParallelGraphCloner/t" + std::to_string(threads) + "/" + label,
+               nodes, [&]() {
+                 bench::doNotOptimize(parallel.cloneGraph(head));
+                 parallel.release();
+               });
+  }
+
+  // The time until the copies `hops` away from the start can be read, and
+  // how many nodes that materializes, against the eager clones above.
+  vector<char> seen(n + 1, 0);
+
+  for (int hops : {0, 1, 2, 4}) {
+    const std::string name =
+        "LazyGraphClone/hops" + std::to_string(hops) + "/" + label;
+
+    runner.run(name, 1, [&]() {
+      LazyGraphClone lazy;
+      bench::doNotOptimize(exploreHops(lazy, lazy.cloneGraph(head), hops, seen));
+    });
+
+    runner.attach(name, "materializedNodes", [&]() {
+      LazyGraphClone lazy;
+      exploreHops(lazy, lazy.cloneGraph(head), hops, seen);
+
+      return std::to_string(lazy.materializedCount());
+    });
+  }
+
+  runner.run("LazyGraphClone/materializeAll/" + label, nodes, [&]() {
+    LazyGraphClone lazy;
+    bench::doNotOptimize(lazy.cloneGraph(head));
+    lazy.materializeAll();
+  });
+}
+
+int main(int argc, char** argv) {
+  bench::Runner runner("clone-graph", argc, argv);
+  bench::Rng rng(runner.seed());
+
+  const int scale = runner.pick(16, 9);
+  benchmarkGraph(runner, "rmat" + std::to_string(scale), 1 << scale,
+                 bench::rmatEdges(scale, 8, rng));
+
+  const int side = runner.pick(256, 16);
+  benchmarkGraph(runner, "grid" + std::to_string(side), side * side,
+                 bench::gridEdges(side, side));
+
+  return runner.finish();
+}
@@ -0,0 +1,65 @@
+/// @brief Converts a text edge list into an edge file that the benchmarks and
+/// the solutions can map with `MappedEdgeFile`.
+///
+/// Usage: `edge-convert [--nodes=N] INPUT OUTPUT`. Without `--nodes`, the
+/// node count is one more than the largest label. The input is streamed, so
+/// its size is not limited by the memory.
+
+#include <charconv>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "edge-file.hpp"
+
+int main(int argc, char** argv) {
+  int nodeCount = -1;
+  std::string paths[2];
+  int pathCount = 0;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string_view arg = argv[i];
+
+    if (arg.starts_with("--nodes=")) {
+      const std::string_view value = arg.substr(8);
+      const auto [end, error] =
+          std::from_chars(value.data(), value.data() + value.size(), nodeCount);
+
+      if (error != std::errc() || end != value.data() + value.size() ||
+          nodeCount < 0) {
+        std::cerr << "edge-convert: bad node count in " << arg << '\n';
+        return 2;
+      }
+    } else if (!arg.starts_with("--") && pathCount < 2) {
+      paths[pathCount++] = arg;
+    } else {
+      pathCount = -1;
+      break;
+    }
+  }
+
+  if (pathCount != 2) {
+    std::cerr << "usage: edge-convert [--nodes=N] INPUT OUTPUT\n";
+    return 2;
+  }
+
+  try {
+    bench::EdgeFileWriter writer(paths[1]);
+
+    bench::forEachTextEdge(paths[0],
+                           [&](int u, int v) { writer.add(u, v); });
+
+    const std::uint64_t edges = writer.size();
+    writer.finish(nodeCount);
+
+    const bench::MappedEdgeFile check(paths[1]);
+    std::cout << "wrote " << edges << " edges over " << check.nodeCount()
+              << " nodes to " << paths[1] << '\n';
+  } catch (const std::exception& error) {
+    std::cerr << "edge-convert: " << error.what() << '\n';
+    return 1;
+  }
+
+  return 0;
+}
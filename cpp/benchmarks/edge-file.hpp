@@ -0,0 +1,450 @@
+/// @brief A compact binary edge-file format, a memory-mapped reader that hands
+/// the edges to the solutions as a `PackedEdges` view, and the text form the
+/// files are converted from.
+///
+/// An edge file is an `EdgeFileHeader` followed by `edgeCount` pairs of int32
+/// node labels, in the byte order of the machine that wrote it. A reader on a
+/// machine with the other byte order sees a wrong version and rejects the
+/// file.
+///
+/// Every label lies in `[0, nodeCount)`, which the reader checks once when it
+/// maps the file, so a damaged file cannot make a solution index out of
+/// bounds. The 1-based problems, star and judge, store `n + 1` nodes.
+///
+/// The text form is any sequence of non-negative integers separated by other
+/// characters, read two at a time, so both `u v` lines and the LeetCode
+/// literal `[[u,v],...]` are accepted.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bench {
+
+static_assert(sizeof(std::array<int, 2>) == 2 * sizeof(std::int32_t),
+              "edge files store node labels as packed int32 pairs");
+
+/// @brief The header at the start of an edge file.
+struct EdgeFileHeader {
+  /// @brief The bytes every edge file starts with.
+  static constexpr std::array<char, 8> expectedMagic = {'L', 'C', 'E', 'D',
+                                                        'G', 'E', 'S', '\0'};
+  /// @brief The version this header describes.
+  static constexpr std::uint32_t currentVersion = 1;
+
+  std::array<char, 8> magic = expectedMagic;
+  std::uint32_t version = currentVersion;
+  /// @brief Unused, zero; keeps the edges 8-byte aligned.
+  std::uint32_t reserved = 0;
+  /// @brief The number of node labels: every label is below it.
+  std::uint64_t nodeCount = 0;
+  /// @brief The number of edges that follow the header.
+  std::uint64_t edgeCount = 0;
+};
+
+static_assert(sizeof(EdgeFileHeader) == 32);
+
+/// @brief Returns an exception describing a failed system call on `path`.
+inline std::runtime_error fileError(const std::string& what,
+                                    const std::string& path) {
+  return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+/// @brief Closes a `std::FILE` owned by a `unique_ptr`.
+struct FileCloser {
+  void operator()(std::FILE* file) const { std::fclose(file); }
+};
+
+/// @class EdgeFileWriter
+/// @brief Streams edges into a new edge file, so that a file larger than the
+/// memory can be converted.
+///
+/// The header is written last, by `finish`, once the number of edges is known.
+class EdgeFileWriter {
+ public:
+  /// @brief Creates or truncates the file at `path`.
+  explicit EdgeFileWriter(const std::string& path)
+      : path(path), file(std::fopen(path.c_str(), "wb")) {
+    if (this->file == nullptr) {
+      throw fileError("cannot create", path);
+    }
+
+    const EdgeFileHeader placeholder;
+
+    if (std::fwrite(&placeholder, sizeof(placeholder), 1, this->file) != 1) {
+      const std::runtime_error error = fileError("cannot write", path);
+      std::fclose(this->file);
+      throw error;
+    }
+
+    this->buffer.reserve(bufferEdges);
+  }
+
+  EdgeFileWriter(const EdgeFileWriter&) = delete;
+  EdgeFileWriter& operator=(const EdgeFileWriter&) = delete;
+
+  ~EdgeFileWriter() {
+    if (this->file != nullptr) {
+      std::fclose(this->file);
+    }
+  }
+
+  /// @brief Appends the edge `[u, v]`.
+  /// @throws std::runtime_error If a label is negative.
+  void add(int u, int v) {
+    if (u < 0 || v < 0) {
+      throw std::runtime_error("negative node label in " + this->path);
+    }
+
+    this->buffer.push_back({u, v});
+    this->largestLabel = std::max({this->largestLabel, u, v});
+
+    if (this->buffer.size() == bufferEdges) {
+      this->flush();
+    }
+  }
+
+  /// @brief Writes the header and closes the file.
+  /// @param nodeCount The number of nodes, or -1 for one more than the largest
+  /// label added.
+  /// @throws std::runtime_error If a label added is not below the node count,
+  /// or the node count does not fit in an `int`.
+  void finish(int nodeCount = -1) {
+    this->flush();
+
+    // A label of INT32_MAX would overflow `largestLabel + 1` as an int.
+    const std::uint64_t labels =
+        static_cast<std::uint64_t>(this->largestLabel + std::int64_t{1});
+    EdgeFileHeader header;
+    header.nodeCount = nodeCount >= 0 ? nodeCount : labels;
+    header.edgeCount = this->edgeCount;
+
+    if (header.nodeCount > static_cast<std::uint64_t>(INT32_MAX)) {
+      throw std::runtime_error("the node count of " + this->path +
+                               " does not fit in an int");
+    }
+
+    if (labels > header.nodeCount) {
+      throw std::runtime_error(
+          "the labels of " + this->path + " need " + std::to_string(labels) +
+          " nodes, but the node count is " + std::to_string(header.nodeCount));
+    }
+
+    if (std::fseek(this->file, 0, SEEK_SET) != 0) {
+      throw fileError("cannot seek in", this->path);
+    }
+
+    this->write(&header, sizeof(header));
+
+    std::FILE* file = std::exchange(this->file, nullptr);
+
+    if (std::fclose(file) != 0) {
+      throw fileError("cannot close", this->path);
+    }
+  }
+
+  /// @brief Returns the number of edges added so far.
+  std::uint64_t size() const { return this->edgeCount + this->buffer.size(); }
+
+ private:
+  /// @brief How many edges are buffered before they are written.
+  static constexpr std::size_t bufferEdges = 1 << 16;
+
+  void flush() {
+    this->write(this->buffer.data(),
+                this->buffer.size() * sizeof(std::array<int, 2>));
+    this->edgeCount += this->buffer.size();
+    this->buffer.clear();
+  }
+
+  void write(const void* data, std::size_t bytes) {
+    if (std::fwrite(data, 1, bytes, this->file) != bytes) {
+      throw fileError("cannot write", this->path);
+    }
+  }
+
+  /// @brief The path of the file, for error messages.
+  std::string path;
+  /// @brief The open file, or null once finished.
+  std::FILE* file;
+  /// @brief The edges not written yet.
+  std::vector<std::array<int, 2>> buffer;
+  /// @brief The number of edges written so far.
+  std::uint64_t edgeCount = 0;
+  /// @brief The largest node label added so far.
+  int largestLabel = -1;
+};
+
+/// @brief Writes `edges` to a new edge file at `path`.
+inline void writeEdgeFile(const std::string& path, int nodeCount,
+                          std::span<const std::array<int, 2>> edges) {
+  EdgeFileWriter writer(path);
+
+  for (const std::array<int, 2>& edge : edges) {
+    writer.add(edge[0], edge[1]);
+  }
+
+  writer.finish(nodeCount);
+}
+
+/// @class MappedEdgeFile
+/// @brief Maps an edge file read-only and exposes its edges in place.
+///
+/// Nothing is copied: the kernel pages the edges in as a solution reads them,
+/// and the view stays valid as long as the object lives.
+class MappedEdgeFile {
+ public:
+  /// @brief Maps and validates the edge file at `path`.
+  explicit MappedEdgeFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+      throw fileError("cannot open", path);
+    }
+
+    struct stat info{};
+
+    if (::fstat(fd, &info) != 0) {
+      const std::runtime_error error = fileError("cannot stat", path);
+      ::close(fd);
+      throw error;
+    }
+
+    this->length = static_cast<std::size_t>(info.st_size);
+
+    if (this->length < sizeof(EdgeFileHeader)) {
+      ::close(fd);
+      throw std::runtime_error(path + " is too short to be an edge file");
+    }
+
+    this->base = ::mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (this->base == MAP_FAILED) {
+      throw fileError("cannot map", path);
+    }
+
+    // The solutions read the edges front to back.
+    ::madvise(this->base, this->length, MADV_SEQUENTIAL);
+
+    const auto* header = static_cast<const EdgeFileHeader*>(this->base);
+    const std::uint64_t payload = this->length - sizeof(EdgeFileHeader);
+
+    if (header->magic != EdgeFileHeader::expectedMagic ||
+        header->version != EdgeFileHeader::currentVersion ||
+        header->nodeCount > static_cast<std::uint64_t>(INT32_MAX) ||
+        payload / sizeof(std::array<int, 2>) != header->edgeCount ||
+        payload % sizeof(std::array<int, 2>) != 0) {
+      ::munmap(this->base, this->length);
+      throw std::runtime_error(path + " is not a valid edge file");
+    }
+
+    this->nodes = static_cast<int>(header->nodeCount);
+    this->edgeCount = static_cast<std::size_t>(header->edgeCount);
+
+    // The solutions index arrays by label without checking, so one pass
+    // checks every label here; a negative label wraps to a huge unsigned one.
+    std::uint32_t largest = 0;
+
+    for (const std::array<int, 2>& edge : this->edges()) {
+      largest = std::max({largest, static_cast<std::uint32_t>(edge[0]),
+                          static_cast<std::uint32_t>(edge[1])});
+    }
+
+    if (this->edgeCount != 0 && largest >= header->nodeCount) {
+      ::munmap(this->base, this->length);
+      throw std::runtime_error(path + " is not a valid edge file: label " +
+                               std::to_string(largest) + " is out of range");
+    }
+  }
+
+  MappedEdgeFile(const MappedEdgeFile&) = delete;
+  MappedEdgeFile& operator=(const MappedEdgeFile&) = delete;
+
+  ~MappedEdgeFile() { ::munmap(this->base, this->length); }
+
+  /// @brief Returns the number of nodes stored in the header; every label is
+  /// below it.
+  int nodeCount() const { return this->nodes; }
+
+  /// @brief Returns the edges, in the `PackedEdges` layout the solutions
+  /// accept.
+  std::span<const std::array<int, 2>> edges() const {
+    return {reinterpret_cast<const std::array<int, 2>*>(
+                static_cast<const char*>(this->base) + sizeof(EdgeFileHeader)),
+            this->edgeCount};
+  }
+
+ private:
+  /// @brief The start of the mapping.
+  void* base = MAP_FAILED;
+  /// @brief The length of the mapping, in bytes.
+  std::size_t length = 0;
+  /// @brief The number of nodes.
+  int nodes = 0;
+  /// @brief The number of edges.
+  std::size_t edgeCount = 0;
+};
+
+/// @brief Parses a text edge list, calling `visit(u, v)` for every edge.
+/// @throws std::runtime_error If the file cannot be read, holds a negative
+/// label or one above `INT32_MAX`, or holds an odd number of labels.
+template <typename Visitor>
+void forEachTextEdge(const std::string& path, Visitor&& visit) {
+  const std::unique_ptr<std::FILE, FileCloser> file(
+      std::fopen(path.c_str(), "rb"));
+
+  if (file == nullptr) {
+    throw fileError("cannot open", path);
+  }
+
+  std::vector<char> chunk(1 << 16);
+  std::array<int, 2> labels{};
+  int have = 0;
+  std::int64_t value = 0;
+  bool inNumber = false;
+  char previous = '\0';
+  std::size_t read = 0;
+
+  auto endNumber = [&]() {
+    labels[have++] = static_cast<int>(value);
+
+    if (have == 2) {
+      visit(labels[0], labels[1]);
+      have = 0;
+    }
+
+    value = 0;
+    inNumber = false;
+  };
+
+  while ((read = std::fread(chunk.data(), 1, chunk.size(), file.get())) > 0) {
+    for (std::size_t i = 0; i < read; i++) {
+      const char c = chunk[i];
+
+      if (c >= '0' && c <= '9') {
+        if (!inNumber && previous == '-') {
+          throw std::runtime_error(path + " holds a negative node label");
+        }
+
+        // Checked on every digit, so `value` never exceeds INT32_MAX * 10 + 9.
+        value = value * 10 + (c - '0');
+        inNumber = true;
+
+        if (value > INT32_MAX) {
+          throw std::runtime_error(path + " holds a node label above " +
+                                   std::to_string(INT32_MAX));
+        }
+      } else if (inNumber) {
+        endNumber();
+      }
+
+      previous = c;
+    }
+  }
+
+  if (std::ferror(file.get()) != 0) {
+    throw fileError("cannot read", path);
+  }
+
+  if (inNumber) {
+    endNumber();
+  }
+
+  if (have != 0) {
+    throw std::runtime_error(path + " holds an odd number of node labels");
+  }
+}
+
+/// @brief Loads a text edge list into the `vector<vector<int>>` layout of the
+/// original LeetCode signatures, one heap-allocated pair per edge.
+inline std::vector<std::vector<int>> readNestedEdges(const std::string& path) {
+  std::vector<std::vector<int>> nested;
+
+  forEachTextEdge(path, [&](int u, int v) { nested.push_back({u, v}); });
+
+  return nested;
+}
+
+/// @brief Writes `edges` as text, one `u v` line per edge.
+inline void writeTextEdges(const std::string& path,
+                           std::span<const std::array<int, 2>> edges) {
+  std::FILE* file = std::fopen(path.c_str(), "w");
+
+  if (file == nullptr) {
+    throw fileError("cannot create", path);
+  }
+
+  for (const std::array<int, 2>& edge : edges) {
+    std::fprintf(file, "%d %d\n", edge[0], edge[1]);
+  }
+
+  if (std::fclose(file) != 0) {
+    throw fileError("cannot write", path);
+  }
+}
+
+/// @class ScratchEdgeFiles
+/// @brief A text and a binary copy of one edge list in the temporary
+/// directory, removed on destruction; the inputs of the loading benchmarks.
+class ScratchEdgeFiles {
+ public:
+  /// @brief Writes both copies.
+  /// @param name A name unique within the process, such as the label of the
+  /// graph; slashes are replaced in the file names.
+  ScratchEdgeFiles(std::string name, int nodeCount,
+                   std::span<const std::array<int, 2>> edges) {
+    std::replace(name.begin(), name.end(), '/', '-');
+
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path();
+    const std::string stem =
+        "bench-" + std::to_string(::getpid()) + "-" + name;
+
+    this->text = (directory / (stem + ".txt")).string();
+    this->binary = (directory / (stem + ".edges")).string();
+
+    writeTextEdges(this->text, edges);
+    writeEdgeFile(this->binary, nodeCount, edges);
+  }
+
+  ScratchEdgeFiles(const ScratchEdgeFiles&) = delete;
+  ScratchEdgeFiles& operator=(const ScratchEdgeFiles&) = delete;
+
+  ~ScratchEdgeFiles() {
+    std::error_code ignored;
+    std::filesystem::remove(this->text, ignored);
+    std::filesystem::remove(this->binary, ignored);
+  }
+
+  /// @brief Returns the path of the text copy.
+  const std::string& textPath() const { return this->text; }
+
+  /// @brief Returns the path of the edge file.
+  const std::string& binaryPath() const { return this->binary; }
+
+ private:
+  std::string text;
+  std::string binary;
+};
+
+}  // namespace bench
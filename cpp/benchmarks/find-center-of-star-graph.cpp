@@ -0,0 +1,72 @@
+/// @brief Benchmarks the star-center lookup and the streaming star validator.
+
+#include "../find-center-of-star-graph.cpp"
+
+#include "benchmark.hpp"
+#include "edge-file.hpp"
+
+int main(int argc, char** argv) {
+  bench::Runner runner("find-center-of-star-graph", argc, argv);
+  bench::Rng rng(runner.seed());
+
+  const int n = runner.pick(2000000, 1000);
+  const bench::EdgeList edges = bench::starEdges(n, rng.below(n) + 1, rng);
+  vector<vector<int>> nested = bench::toNested(edges);
+  const double edgeCount = static_cast<double>(edges.size());
+  const std::string label = "star" + std::to_string(n);
+
+  runner.run("findCenter/nested/" + label, 1, [&]() {
+    bench::doNotOptimize(Solution().findCenter(nested));
+  });
+
+  runner.run("findCenter/packed/" + label, 1, [&]() {
+    bench::doNotOptimize(Solution().findCenter(PackedEdges(edges)));
+  });
+
+  // Labels run from 1 to n.
+  const bench::ScratchEdgeFiles files(label, n + 1, edges);
+
+  runner.run("findCenter/fromText/" + label, edgeCount, [&]() {
+    vector<vector<int>> loaded = bench::readNestedEdges(files.textPath());
+    bench::doNotOptimize(Solution().findCenter(loaded));
+  });
+
+  // Mapping checks every label, so this reads the whole file even though
+  // `findCenter` itself looks at two edges.
+  runner.run("findCenter/fromMapped/" + label, edgeCount, [&]() {
+    const bench::MappedEdgeFile file(files.binaryPath());
+    bench::doNotOptimize(Solution().findCenter(file.edges()));
+  });
+
+  runner.run("StarGraphValidator/perEdge/" + label, edgeCount, [&]() {
+    StarGraphValidator validator;
+
+    for (const std::array<int, 2>& edge : edges) {
+      validator.accept(edge[0], edge[1]);
+    }
+
+    bench::doNotOptimize(validator.currentCenter());
+  });
+
+  runner.run("StarGraphValidator/packed/" + label, edgeCount, [&]() {
+    StarGraphValidator validator;
+    bench::doNotOptimize(validator.accept(PackedEdges(edges)));
+  });
+
+  // A stream whose first edge is a self-loop must be rejected without reading
+  // the rest, so this row should cost the same at any size.
+  bench::EdgeList looped = edges;
+  looped[0] = {looped[0][0], looped[0][0]};
+
+  if (StarGraphValidator().accept(PackedEdges(looped))) {
+    std::cerr << "StarGraphValidator accepted a self-loop\n";
+    return 1;
+  }
+
+  runner.run("StarGraphValidator/rejectFirst/" + label, edgeCount, [&]() {
+    StarGraphValidator validator;
+    bench::doNotOptimize(validator.accept(PackedEdges(looped)));
+  });
+
+  return runner.finish();
+}
@@ -0,0 +1,200 @@
+/// @brief Benchmarks the path-existence engines on R-MAT and grid graphs.
+
+#include <queue>
+#include <unordered_set>
+
+#include "../find-if-path-exists-in-graph.cpp"
+
+#include "benchmark.hpp"
+#include "edge-file.hpp"
+
+/// @class HashSetSolution
+/// @brief The original `Solution`, kept as the baseline of `CompressedGraph`:
+/// it builds a `vector<unordered_set<int>>` adjacency on every call and runs a
+/// BFS that tracks visited nodes in another `unordered_set`.
+class HashSetSolution {
+ public:
+  /// @brief The adjacency of every node as a hash set of neighbors.
+  using AdjanceList = vector<std::unordered_set<int>>;
+
+  bool validPath(int n, const vector<vector<int>>& edges, int source,
+                 int destination) const {
+    AdjanceList adjanceList = this->toAdjanceList(n, edges);
+
+    std::unordered_set<int> seens;
+    std::queue<int> toVisit({source});
+
+    while (!toVisit.empty()) {
+      int current = toVisit.front();
+      toVisit.pop();
+
+      if (current == destination) {
+        return true;
+      }
+
+      seens.insert(current);
+
+      for (auto node : adjanceList[current]) {
+        if (seens.find(node) == seens.end()) {
+          seens.insert(node);
+          toVisit.push(node);
+        }
+      }
+    }
+
+    return false;
+  }
+
+  AdjanceList toAdjanceList(int n, const vector<vector<int>>& edges) const {
+    AdjanceList adjanceList(n);
+
+    for (auto edge : edges) {
+      const int left = edge.at(0);
+      const int right = edge.at(1);
+
+      adjanceList[left].insert(right);
+      adjanceList[right].insert(left);
+    }
+
+    return adjanceList;
+  }
+};
+
+/// @brief Runs every engine over one graph.
+/// @param runner The runner that records the results.
+/// @param label The name of the graph, appended to every benchmark name.
+/// @param n The number of nodes.
+/// @param edges The edges of the graph.
+void benchmarkGraph(bench::Runner& runner, const std::string& label, int n,
+                    const bench::EdgeList& edges) {
+  bench::Rng rng(runner.seed() + 1);
+  const vector<vector<int>> nested = bench::toNested(edges);
+  const vector<pair<int, int>> queries = bench::randomQueries(n, 4096, rng);
+  const double edgeCount = static_cast<double>(edges.size());
+  const CompressedGraph graph(n, PackedEdges(edges));
+  size_t next = 0;
+
+  auto nextQuery = [&]() { return queries[next++ % queries.size()]; };
+
+  runner.run("validPath/hashSet/" + label, edgeCount, [&]() {
+    auto [source, destination] = nextQuery();
+    bench::doNotOptimize(
+        HashSetSolution().validPath(n, nested, source, destination));
+  });
+
+  // From here on `Solution` runs on a `CompressedGraph`, whichever the layout
+  // of its input.
+  runner.run("validPath/nested/" + label, edgeCount, [&]() {
+    auto [source, destination] = nextQuery();
+    bench::doNotOptimize(Solution().validPath(n, nested, source, destination));
+  });
+
+  runner.run("validPath/packed/" + label, edgeCount, [&]() {
+    auto [source, destination] = nextQuery();
+    bench::doNotOptimize(
+        Solution().validPath(n, PackedEdges(edges), source, destination));
+  });
+
+  // The files sit in the page cache, so these measure parsing or mapping,
+  // not the disk.
+  const bench::ScratchEdgeFiles files(label, n, edges);
+
+  runner.run("load/text/" + label, edgeCount, [&]() {
+    bench::doNotOptimize(bench::readNestedEdges(files.textPath()).size());
+  });
+
+  runner.run("load/mapped/" + label, edgeCount, [&]() {
+    const bench::MappedEdgeFile file(files.binaryPath());
+    long long labels = 0;
+
+    for (const array<int, 2>& edge : file.edges()) {
+      labels += edge[0] + edge[1];
+    }
+
+    bench::doNotOptimize(labels);
+  });
+
+  runner.run("validPath/fromText/" + label, edgeCount, [&]() {
+    auto [source, destination] = nextQuery();
+    const vector<vector<int>> loaded = bench::readNestedEdges(files.textPath());
+    bench::doNotOptimize(Solution().validPath(n, loaded, source, destination));
+  });
+
+  runner.run("validPath/fromMapped/" + label, edgeCount, [&]() {
+    auto [source, destination] = nextQuery();
+    const bench::MappedEdgeFile file(files.binaryPath());
+    bench::doNotOptimize(
+        Solution().validPath(n, file.edges(), source, destination));
+  });
+
+  runner.run("AdjanceList/build/" + label, edgeCount, [&]() {
+    bench::doNotOptimize(HashSetSolution().toAdjanceList(n, nested).size());
+  });
+
+  runner.run("CompressedGraph/build/" + label, edgeCount, [&]() {
+    bench::doNotOptimize(CompressedGraph(n, PackedEdges(edges)).edgeSlots());
+  });
+
+  for (bool bidirectional : {false, true}) {
+    FrontierSearch search(graph, bidirectional);
+    const std::string mode = bidirectional ? "bidirectional/" : "forward/";
+
+    runner.run("FrontierSearch/" + mode + label, 1, [&]() {
+      auto [source, destination] = nextQuery();
+      bench::doNotOptimize(search.connects(source, destination));
+    });
+  }
+
+  for (unsigned threads : runner.threadCounts()) {
+    ParallelFrontierSearch parallel(graph, threads);
+
+    runner.run("ParallelFrontierSearch/t" + std::to_string(threads) + "/" +
+                   label,
+               1, [&]() {
+                 auto [source, destination] = nextQuery();
+                 bench::doNotOptimize(parallel.connects(source, destination));
+               });
+  }
+
+  runner.run("ConnectivityIndex/build/" + label, edgeCount, [&]() {
+    ConnectivityIndex index(n, PackedEdges(edges));
+    bench::doNotOptimize(index.connected(0, n - 1));
+  });
+
+  ConnectivityIndex index(n, PackedEdges(edges));
+
+  runner.run("ConnectivityIndex/queries/" + label, queries.size(), [&]() {
+    bench::doNotOptimize(index.connected(queries));
+  });
+
+  MultiSourceReachability reachability(graph);
+  const span<const pair<int, int>> batch(queries.data(), 256);
+
+  runner.run("MultiSourceReachability/" + label, batch.size(), [&]() {
+    bench::doNotOptimize(reachability.reachable(batch));
+  });
+
+  // The same batch answered one query at a time, so the queries per second of
+  // the two rows compare directly.
+  runner.run("validPath/loop256/" + label, batch.size(), [&]() {
+    for (auto [source, destination] : batch) {
+      bench::doNotOptimize(
+          Solution().validPath(n, nested, source, destination));
+    }
+  });
+}
+
+int main(int argc, char** argv) {
+  bench::Runner runner("find-if-path-exists-in-graph", argc, argv);
+  bench::Rng rng(runner.seed());
+
+  const int scale = runner.pick(18, 10);
+  benchmarkGraph(runner, "rmat" + std::to_string(scale), 1 << scale,
+                 bench::rmatEdges(scale, 8, rng));
+
+  const int side = runner.pick(512, 32);
+  benchmarkGraph(runner, "grid" + std::to_string(side), side * side,
+                 bench::gridEdges(side, side));
+
+  return runner.finish();
+}
@@ -0,0 +1,118 @@
+/// @brief Benchmarks the Town Judge finders on dense trust graphs.
+
+#include <set>
+
+#include "../find-the-town-judge.cpp"
+
+#include "benchmark.hpp"
+#include "edge-file.hpp"
+
+/// @class SetSolution
+/// @brief The original `Solution`, kept as the baseline of the balance
+/// kernel: it inserts every truster into a `std::set` and counts the trusted
+/// in a second array.
+class SetSolution {
+ public:
+  int findJudge(int n, vector<vector<int>>& trust) {
+    std::set<int> trustInSomeOne;
+    vector<int> isTrustedBy(n, 0);
+
+    for (auto current = trust.begin(); current != trust.end(); current++) {
+      const int truster = current->at(0);
+      const int trusted = current->at(1);
+
+      trustInSomeOne.insert(truster);
+      isTrustedBy[trusted - 1]++;
+    }
+
+    for (int i = 0; i < n; i++) {
+      const int person = i + 1;
+
+      if (trustInSomeOne.find(person) == trustInSomeOne.end() &&
+          isTrustedBy.at(i) == n - 1) {
+        return person;
+      }
+    }
+
+    return -1;
+  }
+};
+
+/// @brief Runs every finder over one trust graph.
+void benchmarkTown(bench::Runner& runner, const std::string& label, int n,
+                   const bench::EdgeList& trust) {
+  vector<vector<int>> nested = bench::toNested(trust);
+  const double pairs = static_cast<double>(trust.size());
+
+  runner.run("findJudge/set/" + label, pairs, [&]() {
+    bench::doNotOptimize(SetSolution().findJudge(n, nested));
+  });
+
+  // From here on `Solution` runs the balance kernel, whichever the layout of
+  // its input.
+  runner.run("findJudge/nested/" + label, pairs, [&]() {
+    bench::doNotOptimize(Solution().findJudge(n, nested));
+  });
+
+  runner.run("findJudge/packed/" + label, pairs, [&]() {
+    bench::doNotOptimize(Solution().findJudge(n, PackedEdges(trust)));
+  });
+
+  // Labels run from 1 to n.
+  const bench::ScratchEdgeFiles files(label, n + 1, trust);
+
+  runner.run("findJudge/fromText/" + label, pairs, [&]() {
+    vector<vector<int>> loaded = bench::readNestedEdges(files.textPath());
+    bench::doNotOptimize(Solution().findJudge(n, loaded));
+  });
+
+  runner.run("findJudge/fromMapped/" + label, pairs, [&]() {
+    const bench::MappedEdgeFile file(files.binaryPath());
+    bench::doNotOptimize(Solution().findJudge(n, file.edges()));
+  });
+
+  for (unsigned threads : runner.threadCounts()) {
+    const ParallelJudgeFinder parallel(threads);
+
+    runner.run("ParallelJudgeFinder/t" + std::to_string(threads) + "/" + label,
+               pairs, [&]() {
+                 bench::doNotOptimize(
+                     parallel.findJudge(n, PackedEdges(trust)));
+               });
+  }
+
+  // The tracker is asked for the Judge after every batch of relationships,
+  // from one relationship per query to a single query at the end.
+  for (size_t batch : {size_t{1}, size_t{64}, size_t{4096}, trust.size()}) {
+    const std::string size =
+        batch == trust.size() ? "All" : std::to_string(batch);
+
+    runner.run("JudgeTracker/batch" + size + "/" + label, pairs, [&]() {
+      JudgeTracker tracker(n);
+      int judged = 0;
+
+      for (size_t begin = 0; begin < trust.size(); begin += batch) {
+        tracker.addTrusts(PackedEdges(trust).subspan(
+            begin, std::min(batch, trust.size() - begin)));
+        judged += tracker.currentJudge() != -1;
+      }
+
+      bench::doNotOptimize(judged);
+    });
+  }
+}
+
+int main(int argc, char** argv) {
+  bench::Runner runner("find-the-town-judge", argc, argv);
+  bench::Rng rng(runner.seed());
+
+  const int n = runner.pick(2000, 100);
+  const int judge = rng.below(n) + 1;
+
+  benchmarkTown(runner, "dense" + std::to_string(n) + "/judge", n,
+                bench::trustEdges(n, 0.5, judge, rng));
+  benchmarkTown(runner, "dense" + std::to_string(n) + "/noJudge", n,
+                bench::trustEdges(n, 0.5, 0, rng));
+
+  return runner.finish();
+}
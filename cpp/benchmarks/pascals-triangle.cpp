@@ -0,0 +1,139 @@
+/// @brief Benchmarks the Pascal's Triangle generators for small and large
+/// `numRows`.
+
+#include "../pascals-triangle.cpp"
+
+#include "benchmark.hpp"
+
+/// @brief The element type used for triangles too deep for exact integers.
+using Residue = ModularInt<1000000007>;
+
+/// @brief Returns the number of elements in the first `numRows` rows.
+double cellsOf(int numRows) {
+  return static_cast<double>(numRows) * (numRows + 1) / 2;
+}
+
+/// @brief Generates `count` random `(n, k)` queries with `n < rows` and
+/// `0 <= k <= n`.
+vector<std::pair<int, int>> binomialQueries(int rows, int count,
+                                            bench::Rng& rng) {
+  vector<std::pair<int, int>> queries(count);
+
+  for (std::pair<int, int>& query : queries) {
+    query.first = rng.below(rows);
+    query.second = rng.below(query.first + 1);
+  }
+
+  return queries;
+}
+
+int main(int argc, char** argv) {
+  bench::Runner runner("pascals-triangle", argc, argv);
+
+  // Row 33 is the last one whose coefficients all fit in an `int`.
+  const int intRows = 34;
+  const std::string small = "/rows" + std::to_string(intRows);
+
+  runner.run("Solution" + small, cellsOf(intRows), [&]() {
+    bench::doNotOptimize(Solution().generate(intRows));
+  });
+
+  runner.run("PascalTriangle<int>" + small, cellsOf(intRows), [&]() {
+    bench::doNotOptimize(PascalTriangle<int>(intRows).row(intRows - 1));
+  });
+
+  runner.run("binomialRow/row67", exactRows, [&]() {
+    bench::doNotOptimize(binomialRow(exactRows - 1));
+  });
+
+  const int deepRows = runner.pick(4000, 200);
+  const std::string deep = "/rows" + std::to_string(deepRows);
+
+  runner.run("PascalTriangle<ModularInt>" + deep, cellsOf(deepRows), [&]() {
+    bench::doNotOptimize(PascalTriangle<Residue>(deepRows).row(deepRows - 1));
+  });
+
+  runner.run("PascalRow<ModularInt>" + deep, cellsOf(deepRows), [&]() {
+    PascalRow<Residue> row(deepRows - 1);
+
+    while (row.index() < deepRows - 1) {
+      row.advance();
+    }
+
+    bench::doNotOptimize(row.values());
+  });
+
+  for (unsigned threads : runner.threadCounts()) {
+    const ParallelPascalGenerator parallel(threads);
+
+    runner.run("ParallelPascalGenerator<ModularInt>/t" +
+                   std::to_string(threads) + deep,
+               cellsOf(deepRows), [&]() {
+                 uint64_t checksum = 0;
+                 auto sink = [&](span<const Residue> row) {
+                   checksum += row[row.size() / 2].value;
+                 };
+
+                 parallel.generate<Residue>(deepRows, sink);
+                 bench::doNotOptimize(checksum);
+               });
+  }
+
+  const int bigRows = runner.pick(1000, 100);
+
+  runner.run("PascalTriangle<BigNatural>/rows" + std::to_string(bigRows),
+             cellsOf(bigRows), [&]() {
+               bench::doNotOptimize(PascalTriangle<BigNatural>(bigRows).size());
+             });
+
+  const int tableRow = runner.pick(1000000, 10000);
+  const BinomialModTable table(tableRow, 1000000007);
+
+  runner.run("BinomialModTable/build/n" + std::to_string(tableRow), tableRow,
+             [&]() {
+               const BinomialModTable built(tableRow, 1000000007);
+               bench::doNotOptimize(built.choose(tableRow, tableRow / 2));
+             });
+
+  runner.run("BinomialModTable/row/n" + std::to_string(tableRow), tableRow + 1,
+             [&]() { bench::doNotOptimize(table.row(tableRow)); });
+
+  // Single C(n, k) queries, answered directly or by slicing the triangle
+  // `generate` returns, as its callers have to.
+  bench::Rng rng(runner.seed());
+  const vector<std::pair<int, int>> exactQueries =
+      binomialQueries(intRows, 4096, rng);
+  const vector<std::pair<int, int>> deepQueries =
+      binomialQueries(deepRows, 4096, rng);
+  size_t next = 0;
+
+  auto exactQuery = [&]() { return exactQueries[next++ % 4096]; };
+  auto deepQuery = [&]() { return deepQueries[next++ % 4096]; };
+
+  runner.run("choose/exactBinomial" + small, 1, [&]() {
+    auto [n, k] = exactQuery();
+    bench::doNotOptimize(exactBinomial(n, k));
+  });
+
+  runner.run("choose/binomialRow" + small, 1, [&]() {
+    auto [n, k] = exactQuery();
+    bench::doNotOptimize(binomialRow(n)[k]);
+  });
+
+  runner.run("choose/generate" + small, 1, [&]() {
+    auto [n, k] = exactQuery();
+    bench::doNotOptimize(Solution().generate(n + 1)[n][k]);
+  });
+
+  runner.run("choose/BinomialModTable" + deep, 1, [&]() {
+    auto [n, k] = deepQuery();
+    bench::doNotOptimize(table.choose(n, k));
+  });
+
+  runner.run("choose/PascalTriangle<ModularInt>" + deep, 1, [&]() {
+    auto [n, k] = deepQuery();
+    bench::doNotOptimize(PascalTriangle<Residue>(n + 1).row(n)[k].value);
+  });
+
+  return runner.finish();
+}
@@ -0,0 +1,201 @@
+/// @brief Benchmarks the FooBar variants on a high-iteration ping-pong between
+/// two roles.
+
+#include "../print-foobar-alternately.cpp"
+
+#include "benchmark.hpp"
+
+/// @brief Runs `foo` on a new thread and `bar` on the calling one, and waits
+/// for both.
+template <typename Foo, typename Bar>
+void pingPong(Foo&& foo, Bar&& bar) {
+  thread fooThread(std::forward<Foo>(foo));
+  bar();
+  fooThread.join();
+}
+
+/// @brief Times every hand-off of one ping-pong, from the start of one
+/// role's callback to the start of the other's.
+/// @tparam Run A callable that runs the whole ping-pong, given the `foo` and
+/// `bar` callbacks.
+/// @param n The number of rounds.
+/// @return The duration of each of the `2n - 1` hand-offs, in nanoseconds.
+template <typename Run>
+std::vector<double> handOffLatencies(int n, Run&& run) {
+  using Clock = std::chrono::steady_clock;
+
+  // Each role only writes its own vector and time stamp; the other role reads
+  // the time stamp after the hand-off, which orders the accesses.
+  std::vector<double> toFoo, toBar;
+  Clock::time_point fooAt, barAt;
+
+  toFoo.reserve(n);
+  toBar.reserve(n);
+
+  run(
+      [&]() {
+        const Clock::time_point now = Clock::now();
+
+        if (barAt != Clock::time_point()) {
+          toFoo.push_back(std::chrono::duration<double, std::nano>(now - barAt)
+                              .count());
+        }
+
+        fooAt = now;
+      },
+      [&]() {
+        const Clock::time_point now = Clock::now();
+
+        toBar.push_back(
+            std::chrono::duration<double, std::nano>(now - fooAt).count());
+        barAt = now;
+      });
+
+  toBar.insert(toBar.end(), toFoo.begin(), toFoo.end());
+
+  return toBar;
+}
+
+int main(int argc, char** argv) {
+  bench::Runner runner("print-foobar-alternately", argc, argv, {"instances"});
+
+  const int n = runner.pick(200000, 2000);
+  const double handOffs = 2.0 * n;
+  const std::string label = "/n" + std::to_string(n);
+  size_t foos = 0, bars = 0;
+
+  runner.run("FooBar/function" + label, handOffs, [&]() {
+    FooBar fooBar(n);
+    function<void()> printFoo = [&]() { foos++; };
+    function<void()> printBar = [&]() { bars++; };
+
+    pingPong([&]() { fooBar.foo(printFoo); }, [&]() { fooBar.bar(printBar); });
+  });
+
+  runner.run("FooBar/inline" + label, handOffs, [&]() {
+    FooBar fooBar(n);
+
+    pingPong([&]() { fooBar.foo([&]() { foos++; }); },
+             [&]() { fooBar.bar([&]() { bars++; }); });
+  });
+
+  runner.run("FooBar/outsideLock" + label, handOffs, [&]() {
+    FooBar fooBar(n);
+
+    pingPong(
+        [&]() {
+          fooBar.foo<CallbackPlacement::OutsideLock>([&]() { foos++; });
+        },
+        [&]() {
+          fooBar.bar<CallbackPlacement::OutsideLock>([&]() { bars++; });
+        });
+  });
+
+#ifdef ORDERING_INSTRUMENTATION
+  runner.attach("FooBar/inline" + label, "contention", [&]() {
+    FooBar fooBar(n);
+
+    pingPong([&]() { fooBar.foo([&]() { foos++; }); },
+             [&]() { fooBar.bar([&]() { bars++; }); });
+
+    return fooBar.metricsJson();
+  });
+#endif
+
+  const std::pair<const char*, WaitPolicy> policies[] = {
+      {"spin", WaitPolicy::Spin},
+      {"spinThenPark", WaitPolicy::SpinThenPark},
+      {"park", WaitPolicy::Park},
+  };
+
+  for (const auto& [name, policy] : policies) {
+    runner.run("AtomicFooBar/" + std::string(name) + label, handOffs, [&]() {
+      AtomicFooBar fooBar(n, policy);
+
+      pingPong([&]() { fooBar.foo([&]() { foos++; }); },
+               [&]() { fooBar.bar([&]() { bars++; }); });
+    });
+  }
+
+  CoroutinePool pool;
+
+  runner.run("CoroutineFooBar" + label, handOffs, [&]() {
+    CoroutineFooBar fooBar(n);
+
+    fooBar.runOn(pool, [&]() { foos++; }, [&]() { bars++; });
+    pool.wait();
+  });
+
+  // The latency distribution of single hand-offs, which the averages above
+  // hide.
+  runner.runEvents("handOff/FooBar" + label, [&]() {
+    return handOffLatencies(n, [&](auto printFoo, auto printBar) {
+      FooBar fooBar(n);
+
+      pingPong([&]() { fooBar.foo(printFoo); },
+               [&]() { fooBar.bar(printBar); });
+    });
+  });
+
+  for (const auto& [name, policy] : policies) {
+    runner.runEvents(
+        "handOff/AtomicFooBar/" + std::string(name) + label, [&]() {
+          return handOffLatencies(n, [&](auto printFoo, auto printBar) {
+            AtomicFooBar fooBar(n, policy);
+
+            pingPong([&]() { fooBar.foo(printFoo); },
+                     [&]() { fooBar.bar(printBar); });
+          });
+        });
+  }
+
+  runner.runEvents("handOff/CoroutineFooBar" + label, [&]() {
+    return handOffLatencies(n, [&](auto printFoo, auto printBar) {
+      CoroutineFooBar fooBar(n);
+
+      fooBar.runOn(pool, printFoo, printBar);
+      pool.wait();
+    });
+  });
+
+  // Many independent instances at once: two threads each, against coroutine
+  // frames on one pool. The RSS column holds the memory of all instances.
+  const int instances =
+      static_cast<int>(runner.option("instances", runner.pick(10000, 200)));
+  const int instanceRounds = runner.pick(100, 10);
+  const std::string many = "/instances" + std::to_string(instances) + "/n" +
+                           std::to_string(instanceRounds);
+  const double manyHandOffs = 2.0 * instances * instanceRounds;
+
+  runner.run("FooBar/threadPerRole" + many, manyHandOffs, [&]() {
+    deque<FooBar> fooBars;
+    vector<thread> threads;
+
+    threads.reserve(2 * instances);
+
+    for (int i = 0; i < instances; i++) {
+      FooBar& fooBar = fooBars.emplace_back(instanceRounds);
+
+      threads.emplace_back([&fooBar]() { fooBar.foo([]() {}); });
+      threads.emplace_back([&fooBar]() { fooBar.bar([]() {}); });
+    }
+
+    for (thread& role : threads) {
+      role.join();
+    }
+  });
+
+  runner.run("CoroutineFooBar" + many, manyHandOffs, [&]() {
+    deque<CoroutineFooBar> fooBars;
+
+    for (int i = 0; i < instances; i++) {
+      fooBars.emplace_back(instanceRounds).runOn(pool, []() {}, []() {});
+    }
+
+    pool.wait();
+  });
+
+  bench::doNotOptimize(foos + bars);
+
+  return runner.finish();
+}
@@ -0,0 +1,165 @@
+/// @brief Benchmarks the ordered-stage classes: one-shot `Foo` sequences and
+/// many rounds of three stages.
+
+#include "../print-in-order.cpp"
+
+#include "benchmark.hpp"
+
+/// @brief Runs the three callables on three threads, the third one on the
+/// calling thread, and waits for all of them.
+template <typename First, typename Second, typename Third>
+void runStages(First&& first, Second&& second, Third&& third) {
+  thread firstThread(std::forward<First>(first));
+  thread secondThread(std::forward<Second>(second));
+  third();
+  firstThread.join();
+  secondThread.join();
+}
+
+/// @class NotifyAllStages
+/// @brief `N` ordered stages built the way `Foo` is: one mutex, one turn
+/// counter and one condition variable that every stage waits on, so each
+/// hand-off wakes all of them. The baseline of `DynamicOrderedStages`.
+class NotifyAllStages {
+ public:
+  explicit NotifyAllStages(size_t stageCount) : stageCount(stageCount) {}
+
+  /// @brief Executes a stage once every earlier stage of the round has run.
+  template <typename Action>
+  void run(size_t stage, Action&& action) {
+    unique_lock<mutex> lock(this->turnMutex);
+    this->turnCV.wait(lock, [&]() { return this->turn == stage; });
+
+    action();
+
+    this->turn = (stage + 1) % this->stageCount;
+    this->turnCV.notify_all();
+  }
+
+ private:
+  size_t stageCount;
+  size_t turn = 0;
+  mutex turnMutex;
+  condition_variable turnCV;
+};
+
+/// @brief Runs `rounds` rounds of `stageCount` stages, one thread per stage,
+/// stage 0 on the calling thread.
+template <typename Stages, typename Action>
+void runRounds(Stages& stages, size_t stageCount, int rounds, Action& action) {
+  auto loop = [&](size_t stage) {
+    for (int round = 0; round < rounds; round++) {
+      stages.run(stage, action);
+    }
+  };
+  vector<thread> threads;
+
+  for (size_t stage = 1; stage < stageCount; stage++) {
+    threads.emplace_back(loop, stage);
+  }
+
+  loop(0);
+
+  for (thread& stage : threads) {
+    stage.join();
+  }
+}
+
+int main(int argc, char** argv) {
+  bench::Runner runner("print-in-order", argc, argv);
+
+  size_t printed = 0;
+  auto print = [&]() { printed++; };
+
+  // A `Foo` orders a single round, so each call pays for starting threads as
+  // the original problem does.
+  runner.run("Foo/function", 3, [&]() {
+    Foo foo;
+    function<void()> step = print;
+
+    runStages([&]() { foo.first(step); }, [&]() { foo.second(step); },
+              [&]() { foo.third(step); });
+  });
+
+  runner.run("Foo/inline", 3, [&]() {
+    Foo foo;
+
+    runStages([&]() { foo.first(print); }, [&]() { foo.second(print); },
+              [&]() { foo.third(print); });
+  });
+
+#ifdef ORDERING_INSTRUMENTATION
+  runner.attach("Foo/inline", "contention", [&]() {
+    Foo foo;
+
+    runStages([&]() { foo.first(print); }, [&]() { foo.second(print); },
+              [&]() { foo.third(print); });
+
+    return foo.metricsJson();
+  });
+#endif
+
+  CoroutinePool pool;
+
+  runner.run("CoroutineFoo", 3, [&]() {
+    CoroutineFoo foo;
+
+    foo.runOn(pool, print, print, print);
+    pool.wait();
+  });
+
+  const int rounds = runner.pick(100000, 1000);
+  const std::string label = "/rounds" + std::to_string(rounds);
+
+  runner.run("OrderedStages<3>" + label, 3.0 * rounds, [&]() {
+    OrderedStages<3> stages;
+    auto loop = [&](size_t stage) {
+      return [&stages, &print, stage, rounds]() {
+        for (int round = 0; round < rounds; round++) {
+          stages.run(stage, print);
+        }
+      };
+    };
+
+    runStages(loop(0), loop(1), loop(2));
+  });
+
+  runner.run("DynamicOrderedStages(3)" + label, 3.0 * rounds, [&]() {
+    DynamicOrderedStages stages(3);
+    auto loop = [&](size_t stage) {
+      return [&stages, &print, stage, rounds]() {
+        for (int round = 0; round < rounds; round++) {
+          stages.run(stage, print);
+        }
+      };
+    };
+
+    runStages(loop(0), loop(1), loop(2));
+  });
+
+  // How each design scales with the number of stages, for the same number of
+  // hand-offs: notify_all wakes every stage on every hand-off, the permit
+  // slots wake only the next one.
+  const int handOffs = runner.pick(30000, 600);
+
+  for (size_t stageCount : {3, 8, 16, 32}) {
+    const int stageRounds = handOffs / static_cast<int>(stageCount);
+    const std::string shape = "(" + std::to_string(stageCount) + ")/rounds" +
+                              std::to_string(stageRounds);
+    const double stageCalls = static_cast<double>(stageCount) * stageRounds;
+
+    runner.run("NotifyAllStages" + shape, stageCalls, [&]() {
+      NotifyAllStages stages(stageCount);
+      runRounds(stages, stageCount, stageRounds, print);
+    });
+
+    runner.run("DynamicOrderedStages" + shape, stageCalls, [&]() {
+      DynamicOrderedStages stages(stageCount);
+      runRounds(stages, stageCount, stageRounds, print);
+    });
+  }
+
+  bench::doNotOptimize(printed);
+
+  return runner.finish();
+}
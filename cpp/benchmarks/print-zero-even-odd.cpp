@@ -0,0 +1,164 @@
+/// @brief Benchmarks the ZeroEvenOdd variants on a long `0 1 0 2 ...`
+/// sequence.
+
+#include "../print-zero-even-odd.cpp"
+
+#include "benchmark.hpp"
+
+/// @brief Runs `zero` and `even` on new threads and `odd` on the calling one,
+/// and waits for all of them.
+template <typename Zero, typename Even, typename Odd>
+void runRoles(Zero&& zero, Even&& even, Odd&& odd) {
+  thread zeroThread(std::forward<Zero>(zero));
+  thread evenThread(std::forward<Even>(even));
+  odd();
+  zeroThread.join();
+  evenThread.join();
+}
+
+/// @brief Returns the blocking-wait counters of a `TargetedZeroEvenOdd` as
+/// JSON.
+std::string wakeStatsJson(const TargetedZeroEvenOdd& sequence) {
+  const std::pair<const char*, TargetedZeroEvenOdd::WakeStats> roles[] = {
+      {"zero", sequence.zeroWakeStats()},
+      {"even", sequence.evenWakeStats()},
+      {"odd", sequence.oddWakeStats()},
+  };
+  std::string json = "{";
+
+  for (const auto& [role, stats] : roles) {
+    json += std::string(json.size() == 1 ? "" : ",") + "\"" + role +
+            "\":{\"blockingWaits\":" + std::to_string(stats.blockingWaits) +
+            ",\"wakeUps\":" + std::to_string(stats.wakeUps) +
+            ",\"spuriousWakeUps\":" + std::to_string(stats.spuriousWakeUps) +
+            "}";
+  }
+
+  return json + "}";
+}
+
+int main(int argc, char** argv) {
+  bench::Runner runner("print-zero-even-odd", argc, argv, {"instances"});
+
+  const int n = runner.pick(200000, 2000);
+  const double numbers = 2.0 * n;
+  const std::string label = "/n" + std::to_string(n);
+  int64_t checksum = 0;
+  auto print = [&](int number) { checksum += number; };
+
+  runner.run("ZeroEvenOdd/function" + label, numbers, [&]() {
+    ZeroEvenOdd sequence(n);
+    function<void(int)> printNumber = print;
+
+    runRoles([&]() { sequence.zero(printNumber); },
+             [&]() { sequence.even(printNumber); },
+             [&]() { sequence.odd(printNumber); });
+  });
+
+  runner.run("ZeroEvenOdd/inline" + label, numbers, [&]() {
+    ZeroEvenOdd sequence(n);
+
+    runRoles([&]() { sequence.zero(print); }, [&]() { sequence.even(print); },
+             [&]() { sequence.odd(print); });
+  });
+
+#ifdef ORDERING_INSTRUMENTATION
+  runner.attach("ZeroEvenOdd/inline" + label, "contention", [&]() {
+    ZeroEvenOdd sequence(n);
+
+    runRoles([&]() { sequence.zero(print); }, [&]() { sequence.even(print); },
+             [&]() { sequence.odd(print); });
+
+    return sequence.metricsJson();
+  });
+#endif
+
+  runner.run("TargetedZeroEvenOdd" + label, numbers, [&]() {
+    TargetedZeroEvenOdd sequence(n);
+
+    runRoles([&]() { sequence.zero(print); }, [&]() { sequence.even(print); },
+             [&]() { sequence.odd(print); });
+  });
+
+  runner.attach("TargetedZeroEvenOdd" + label, "wakeStats", [&]() {
+    TargetedZeroEvenOdd sequence(n);
+
+    runRoles([&]() { sequence.zero(print); }, [&]() { sequence.even(print); },
+             [&]() { sequence.odd(print); });
+
+    return wakeStatsJson(sequence);
+  });
+
+  // The batched version also runs on the longest sequences, which would take
+  // minutes with one hand-off per number.
+  for (int length : {n, runner.pick(100000000, 200000)}) {
+    runner.run("BatchedZeroEvenOdd/n" + std::to_string(length), 2.0 * length,
+               [&]() {
+                 BatchedZeroEvenOdd sequence(length);
+                 thread zeroThread([&]() { sequence.zero(); });
+                 thread evenThread([&]() { sequence.even(); });
+                 thread oddThread([&]() { sequence.odd(); });
+
+                 sequence.consume([&](span<const int> batch) {
+                   for (int number : batch) {
+                     checksum += number;
+                   }
+                 });
+
+                 zeroThread.join();
+                 evenThread.join();
+                 oddThread.join();
+               });
+  }
+
+  CoroutinePool pool;
+
+  runner.run("CoroutineZeroEvenOdd" + label, numbers, [&]() {
+    CoroutineZeroEvenOdd sequence(n);
+
+    sequence.runOn(pool, print);
+    pool.wait();
+  });
+
+  // Many independent instances at once: three threads each, against coroutine
+  // frames on one pool. The RSS column holds the memory of all instances.
+  const int instances =
+      static_cast<int>(runner.option("instances", runner.pick(10000, 200)));
+  const int instanceLength = runner.pick(100, 10);
+  const std::string many = "/instances" + std::to_string(instances) + "/n" +
+                           std::to_string(instanceLength);
+  const double manyNumbers = 2.0 * instances * instanceLength;
+
+  runner.run("ZeroEvenOdd/threadPerRole" + many, manyNumbers, [&]() {
+    deque<ZeroEvenOdd> sequences;
+    vector<thread> threads;
+
+    threads.reserve(3 * instances);
+
+    for (int i = 0; i < instances; i++) {
+      ZeroEvenOdd& sequence = sequences.emplace_back(instanceLength);
+
+      threads.emplace_back([&sequence]() { sequence.zero([](int) {}); });
+      threads.emplace_back([&sequence]() { sequence.even([](int) {}); });
+      threads.emplace_back([&sequence]() { sequence.odd([](int) {}); });
+    }
+
+    for (thread& role : threads) {
+      role.join();
+    }
+  });
+
+  runner.run("CoroutineZeroEvenOdd" + many, manyNumbers, [&]() {
+    deque<CoroutineZeroEvenOdd> sequences;
+
+    for (int i = 0; i < instances; i++) {
+      sequences.emplace_back(instanceLength).runOn(pool, [](int) {});
+    }
+
+    pool.wait();
+  });
+
+  bench::doNotOptimize(checksum);
+
+  return runner.finish();
+}
@@ -1,12 +1,30 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <stack>
+#include <thread>
 #include <tuple>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
+using std::atomic;
+using std::deque;
+using std::lock_guard;
 using std::map;
+using std::mutex;
+using std::pair;
+using std::size_t;
 using std::stack;
+using std::thread;
 using std::tuple;
+using std::unique_ptr;
 using std::unordered_set;
 using std::vector;
 
@@ -98,4 +116,578 @@ class Solution {
   bool setContains(const unordered_set<Node*>& set, Node* node) const {
     return set.find(node) != set.end();
   }
+};
+
+/// @class NodeArena
+/// @brief A bump allocator that hands out `Node` objects from large chunks.
+///
+/// Nodes are constructed in place, one after another, inside chunks that
+/// double in size whenever the current one is full. Nothing is freed one node
+/// at a time: `release` destroys every node and returns every chunk at once.
+class NodeArena {
+ public:
+  NodeArena() = default;
+  NodeArena(const NodeArena&) = delete;
+  NodeArena& operator=(const NodeArena&) = delete;
+
+  ~NodeArena() { this->release(); }
+
+  /// @brief Constructs a new node in the arena.
+  /// @param val The value of the new node.
+  /// @return A pointer to the node, valid until the arena is released.
+  Node* create(int val) {
+    if (this->chunks.empty() || this->used == this->chunks.back().second) {
+      this->grow();
+    }
+
+    Node* slot = this->chunks.back().first + this->used++;
+
+    return std::construct_at(slot, val);
+  }
+
+  /// @brief Destroys every node and frees every chunk.
+  void release() {
+    std::allocator<Node> allocator;
+
+    for (size_t i = 0; i < this->chunks.size(); i++) {
+      auto [chunk, capacity] = this->chunks[i];
+      const bool isLast = i + 1 == this->chunks.size();
+
+      std::destroy_n(chunk, isLast ? this->used : capacity);
+      allocator.deallocate(chunk, capacity);
+    }
+
+    this->chunks.clear();
+    this->used = 0;
+  }
+
+  /// @brief Returns how many chunks the arena has allocated.
+  size_t chunkCount() const { return this->chunks.size(); }
+
+ private:
+  /// @brief The number of nodes held by the first chunk.
+  static constexpr size_t firstChunkSize = 64;
+
+  /// @brief Opens a new chunk twice as large as the previous one.
+  void grow() {
+    const size_t capacity = this->chunks.empty()
+                                ? firstChunkSize
+                                : 2 * this->chunks.back().second;
+
+    this->chunks.emplace_back(std::allocator<Node>().allocate(capacity),
+                              capacity);
+    this->used = 0;
+  }
+
+  /// @brief Every chunk with its capacity, in allocation order.
+  vector<pair<Node*, size_t>> chunks;
+  /// @brief How many nodes of the last chunk are in use.
+  size_t used = 0;
+};
+
+/// @class NodeAddressTable
+/// @brief A flat open-addressing map from original nodes to their copies.
+///
+/// Keys and values sit side by side in one array, probed linearly from a
+/// Fibonacci hash of the key's address, and the table doubles whenever it
+/// becomes half full.
+class NodeAddressTable {
+ public:
+  NodeAddressTable() : slots(minCapacity) {}
+
+  /// @brief Finds the copy of a node.
+  /// @param original The node to look up.
+  /// @return The copy, or `nullptr` if `original` has none yet.
+  Node* find(Node* original) const {
+    for (size_t i = this->indexOf(original);; i = this->nextIndex(i)) {
+      if (this->slots[i].first == original) {
+        return this->slots[i].second;
+      }
+
+      if (this->slots[i].first == nullptr) {
+        return nullptr;
+      }
+    }
+  }
+
+  /// @brief Records the copy of a node that is not in the table yet.
+  /// @param original The node that was copied.
+  /// @param copy The copy of `original`.
+  void insert(Node* original, Node* copy) {
+    if (2 * (this->count + 1) > this->slots.size()) {
+      this->rehash(2 * this->slots.size());
+    }
+
+    size_t i = this->indexOf(original);
+
+    while (this->slots[i].first != nullptr) {
+      i = this->nextIndex(i);
+    }
+
+    this->slots[i] = {original, copy};
+    this->count++;
+  }
+
+  /// @brief Returns the number of nodes in the table.
+  size_t size() const { return this->count; }
+
+  /// @brief Returns how many slot arrays the table has allocated.
+  size_t allocationCount() const { return this->allocations; }
+
+ private:
+  /// @brief The capacity of an empty table, a power of two.
+  static constexpr size_t minCapacity = 16;
+
+  /// @brief Returns the home slot of a key.
+  size_t indexOf(Node* key) const {
+    const uint64_t hash =
+        reinterpret_cast<std::uintptr_t>(key) * 0x9E3779B97F4A7C15ull;
+    const int shift = 64 - std::countr_zero(this->slots.size());
+
+    return static_cast<size_t>(hash >> shift);
+  }
+
+  /// @brief Returns the slot probed after `i`.
+  size_t nextIndex(size_t i) const { return (i + 1) & (this->slots.size() - 1); }
+
+  /// @brief Moves every entry into a table of the given capacity.
+  void rehash(size_t capacity) {
+    vector<pair<Node*, Node*>> previous(capacity);
+    previous.swap(this->slots);
+    this->count = 0;
+    this->allocations++;
+
+    for (auto [original, copy] : previous) {
+      if (original != nullptr) {
+        this->insert(original, copy);
+      }
+    }
+  }
+
+  /// @brief The `(original, copy)` pairs; empty slots hold `nullptr` keys.
+  vector<pair<Node*, Node*>> slots;
+  /// @brief The number of occupied slots.
+  size_t count = 0;
+  /// @brief The number of slot arrays allocated so far.
+  size_t allocations = 1;
+};
+
+/// @class ArenaGraphCloner
+/// @brief Clones graphs in a single pass into arena-allocated nodes.
+///
+/// Unlike `Solution`, which first lists every node and then copies them
+/// through an ordered `map`, this cloner copies each node the moment it is
+/// discovered, keeps the original-to-copy mapping in a `NodeAddressTable`, and
+/// reserves every neighbor list at its final size. The clones belong to the
+/// cloner: they stay valid until `release` is called or the cloner is
+/// destroyed, and are never deleted individually.
+class ArenaGraphCloner {
+ public:
+  /// @brief Counters describing the work done by the last clone.
+  struct Stats {
+    /// @brief The number of nodes copied.
+    size_t nodes = 0;
+    /// @brief The number of heap allocations made, counting arena chunks,
+    /// neighbor lists and growth of the mapping table and the DFS stack.
+    size_t allocations = 0;
+  };
+
+  /// @brief Creates a deep copy of a given undirected graph.
+  ///
+  /// The method runs an iterative DFS. A node's copy is created and pushed on
+  /// the stack the first time the node is seen, and its neighbors are wired
+  /// when it is popped, so every node is visited exactly once.
+  ///
+  /// @param node The starting node of the graph to be cloned.
+  /// @return A pointer to the copied starting node, or `nullptr` if the input
+  /// is `nullptr`.
+  Node* cloneGraph(Node* node) {
+    this->stats = Stats();
+
+    if (node == nullptr) {
+      return nullptr;
+    }
+
+    const size_t chunksBefore = this->arena.chunkCount();
+    NodeAddressTable copies;
+    vector<Node*> nexts;
+
+    Node* head = this->copyOf(node, copies, nexts);
+
+    while (!nexts.empty()) {
+      Node* current = nexts.back();
+      nexts.pop_back();
+
+      Node* copy = copies.find(current);
+      copy->neighbors.reserve(current->neighbors.size());
+
+      if (!current->neighbors.empty()) {
+        this->stats.allocations++;
+      }
+
+      for (Node* neighbor : current->neighbors) {
+        Node* neighborCopy = copies.find(neighbor);
+
+        if (neighborCopy == nullptr) {
+          neighborCopy = this->copyOf(neighbor, copies, nexts);
+        }
+
+        copy->neighbors.push_back(neighborCopy);
+      }
+    }
+
+    this->stats.nodes = copies.size();
+    this->stats.allocations +=
+        this->arena.chunkCount() - chunksBefore + copies.allocationCount();
+
+    return head;
+  }
+
+  /// @brief Frees every graph cloned so far.
+  void release() { this->arena.release(); }
+
+  /// @brief Returns the counters of the last call to `cloneGraph`.
+  const Stats& lastStats() const { return this->stats; }
+
+ private:
+  /// @brief Copies a newly discovered node and schedules it for wiring.
+  Node* copyOf(Node* original, NodeAddressTable& copies,
+               vector<Node*>& nexts) {
+    Node* copy = this->arena.create(original->val);
+    const size_t stackCapacity = nexts.capacity();
+
+    copies.insert(original, copy);
+    nexts.push_back(original);
+
+    if (nexts.capacity() != stackCapacity) {
+      this->stats.allocations++;
+    }
+
+    return copy;
+  }
+
+  /// @brief The storage of every cloned node.
+  NodeArena arena;
+  /// @brief The counters of the last clone.
+  Stats stats;
+};
+
+/// @class ParallelGraphCloner
+/// @brief Clones graphs on several threads with a work-stealing traversal.
+///
+/// The clone runs in two phases. During discovery, every worker pops nodes
+/// from the back of its own queue and, when that queue runs dry, steals from
+/// the front of the others. Each neighbor is claimed through a sharded
+/// concurrent map, and the worker that claims a node copies it right away into
+/// its own `NodeArena` and queues it. Once every node has been claimed, the
+/// workers wire the neighbor lists in parallel, each over a disjoint range of
+/// the claimed nodes. Neighbors are wired in their original order, so the
+/// result is structurally identical to the one built by `Solution`.
+class ParallelGraphCloner {
+ public:
+  /// @brief Creates a cloner that runs on the given number of threads.
+  /// @param threads The number of workers. Zero picks one worker per hardware
+  /// thread.
+  explicit ParallelGraphCloner(unsigned threads = 0)
+      : threads(threads != 0 ? threads
+                             : std::max(1u, thread::hardware_concurrency())),
+        arenas(std::make_unique<NodeArena[]>(this->threads)),
+        queues(std::make_unique<WorkQueue[]>(this->threads)),
+        claimed(this->threads) {}
+
+  /// @brief Creates a deep copy of a given undirected graph.
+  /// @param node The starting node of the graph to be cloned.
+  /// @return A pointer to the copied starting node, or `nullptr` if the input
+  /// is `nullptr`. The clone stays valid until `release` is called or the
+  /// cloner is destroyed.
+  Node* cloneGraph(Node* node) {
+    if (node == nullptr) {
+      return nullptr;
+    }
+
+    this->shards = std::make_unique<Shard[]>(shardCount);
+
+    this->pending.store(0);
+    Node* head = this->claim(node, 0);
+
+    this->runWorkers([this](unsigned worker) { this->discover(worker); });
+
+    vector<pair<Node*, Node*>> nodes;
+
+    for (vector<pair<Node*, Node*>>& found : this->claimed) {
+      nodes.insert(nodes.end(), found.begin(), found.end());
+      found.clear();
+    }
+
+    this->runWorkers([this, &nodes](unsigned worker) {
+      const size_t begin = nodes.size() * worker / this->threads;
+      const size_t end = nodes.size() * (worker + 1) / this->threads;
+
+      for (size_t i = begin; i < end; i++) {
+        this->wire(nodes[i].first, nodes[i].second);
+      }
+    });
+
+    this->shards.reset();
+
+    return head;
+  }
+
+  /// @brief Frees every graph cloned so far.
+  void release() {
+    for (unsigned worker = 0; worker < this->threads; worker++) {
+      this->arenas[worker].release();
+    }
+  }
+
+ private:
+  /// @brief The number of independently locked parts of the concurrent map.
+  static constexpr size_t shardCount = 64;
+
+  /// @brief One part of the concurrent original-to-copy map.
+  struct Shard {
+    mutex lock;
+    NodeAddressTable copies;
+  };
+
+  /// @brief The queue of claimed nodes whose neighbors are still unexplored.
+  struct WorkQueue {
+    mutex lock;
+    deque<Node*> nodes;
+  };
+
+  /// @brief Runs `task(worker)` on every worker and waits for all of them.
+  template <typename Task>
+  void runWorkers(const Task& task) {
+    vector<thread> workers;
+
+    for (unsigned worker = 1; worker < this->threads; worker++) {
+      workers.emplace_back(task, worker);
+    }
+
+    task(0);
+
+    for (thread& worker : workers) {
+      worker.join();
+    }
+  }
+
+  /// @brief Explores claimed nodes until no worker has anything left.
+  ///
+  /// `pending` counts the nodes that were claimed but not yet explored.
+  /// `claim` counts a node before queueing it, so no worker can explore and
+  /// discount a node that is not counted yet, and a node's neighbors are all
+  /// claimed before the node itself is discounted. The counter therefore only
+  /// reaches zero once the whole graph has been discovered.
+  void discover(unsigned worker) {
+    while (this->pending.load() != 0) {
+      Node* current = this->take(worker);
+
+      if (current == nullptr) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      for (Node* neighbor : current->neighbors) {
+        this->claim(neighbor, worker);
+      }
+
+      this->pending.fetch_sub(1);
+    }
+  }
+
+  /// @brief Takes a node from the worker's own queue, or steals one.
+  /// @return The node to explore, or `nullptr` if every queue was empty.
+  Node* take(unsigned worker) {
+    for (unsigned i = 0; i < this->threads; i++) {
+      const unsigned victim = (worker + i) % this->threads;
+      WorkQueue& queue = this->queues[victim];
+      lock_guard<mutex> lock(queue.lock);
+
+      if (queue.nodes.empty()) {
+        continue;
+      }
+
+      Node* node;
+
+      if (victim == worker) {
+        node = queue.nodes.back();
+        queue.nodes.pop_back();
+      } else {
+        node = queue.nodes.front();
+        queue.nodes.pop_front();
+      }
+
+      return node;
+    }
+
+    return nullptr;
+  }
+
+  /// @brief Copies `original` if no worker has claimed it yet, and counts it
+  /// in `pending` before queueing it.
+  /// @return The new copy, or `nullptr` if the node was already claimed.
+  Node* claim(Node* original, unsigned worker) {
+    Shard& shard = this->shardOf(original);
+    Node* copy;
+
+    {
+      lock_guard<mutex> lock(shard.lock);
+
+      if (shard.copies.find(original) != nullptr) {
+        return nullptr;
+      }
+
+      copy = this->arenas[worker].create(original->val);
+      shard.copies.insert(original, copy);
+    }
+
+    this->claimed[worker].emplace_back(original, copy);
+    this->pending.fetch_add(1);
+
+    WorkQueue& queue = this->queues[worker];
+    lock_guard<mutex> lock(queue.lock);
+    queue.nodes.push_back(original);
+
+    return copy;
+  }
+
+  /// @brief Fills the neighbor list of `copy` from that of `original`.
+  ///
+  /// It runs after discovery has finished, when the map is no longer
+  /// written, so the lookups take no locks.
+  void wire(Node* original, Node* copy) {
+    copy->neighbors.reserve(original->neighbors.size());
+
+    for (Node* neighbor : original->neighbors) {
+      copy->neighbors.push_back(this->shardOf(neighbor).copies.find(neighbor));
+    }
+  }
+
+  /// @brief Returns the shard responsible for a node.
+  Shard& shardOf(Node* node) {
+    const uint64_t hash =
+        reinterpret_cast<std::uintptr_t>(node) * 0x9E3779B97F4A7C15ull;
+
+    return this->shards[hash >> (64 - std::countr_zero(shardCount))];
+  }
+
+  /// @brief The number of workers.
+  unsigned threads;
+  /// @brief The storage of the nodes copied by each worker.
+  unique_ptr<NodeArena[]> arenas;
+  /// @brief The work queue of each worker.
+  unique_ptr<WorkQueue[]> queues;
+  /// @brief The concurrent original-to-copy map of the clone in progress.
+  unique_ptr<Shard[]> shards;
+  /// @brief The `(original, copy)` pairs claimed by each worker.
+  vector<vector<pair<Node*, Node*>>> claimed;
+  /// @brief The number of claimed nodes that are not explored yet.
+  atomic<size_t> pending = 0;
+};
+
+/// @class LazyGraphClone
+/// @brief Clones a graph on demand, copying only the nodes that are reached.
+///
+/// `cloneGraph` copies just the starting node and returns at once. The
+/// neighbor list of a copy is filled the first time it is read through
+/// `neighborsOf`, which copies the neighbors that have not been copied yet.
+/// Both directions of the original-to-copy mapping are memoized, so shared
+/// nodes and cycles always resolve to the same copy. Reading `neighbors` of a
+/// copy directly only gives the full list once that copy has been
+/// materialized, and `materializeAll` materializes every reachable node. The
+/// copies live in a `NodeArena` owned by this object.
+///
+/// The mapping persists across `cloneGraph` calls on the same object. A later
+/// call on a graph that overlaps an earlier one returns the copies already
+/// built for the shared nodes, so use a fresh object for an independent
+/// clone.
+class LazyGraphClone {
+ public:
+  /// @brief Starts a lazy deep copy of a given undirected graph.
+  /// @param node The starting node of the graph to be cloned.
+  /// @return The copy of the starting node, with its neighbors not yet
+  /// filled, or `nullptr` if the input is `nullptr`.
+  Node* cloneGraph(Node* node) {
+    if (node == nullptr) {
+      return nullptr;
+    }
+
+    return this->copyOf(node);
+  }
+
+  /// @brief Returns the neighbors of a copy, materializing them if needed.
+  ///
+  /// A copy is materialized only once; a caller may then change its
+  /// `neighbors` freely, and later calls return the list as changed.
+  ///
+  /// @param copy A node returned by this object.
+  /// @return The fully populated neighbor list of `copy`.
+  const vector<Node*>& neighborsOf(Node* copy) {
+    if (this->wired.find(copy) == nullptr) {
+      Node* original = this->originals.find(copy);
+
+      this->wire(original, copy);
+      this->wired.insert(copy, original);
+    }
+
+    return copy->neighbors;
+  }
+
+  /// @brief Materializes every node reachable from the copies made so far,
+  /// turning the lazy clone into a full deep copy.
+  void materializeAll() {
+    vector<Node*> pending(this->created.begin(), this->created.end());
+
+    while (!pending.empty()) {
+      Node* copy = pending.back();
+      pending.pop_back();
+
+      const size_t before = this->created.size();
+
+      this->neighborsOf(copy);
+
+      pending.insert(pending.end(), this->created.begin() + before,
+                     this->created.end());
+    }
+  }
+
+  /// @brief Returns how many nodes have been copied so far.
+  size_t materializedCount() const { return this->created.size(); }
+
+ private:
+  /// @brief Returns the copy of `original`, creating it if needed.
+  Node* copyOf(Node* original) {
+    Node* copy = this->copies.find(original);
+
+    if (copy == nullptr) {
+      copy = this->arena.create(original->val);
+      this->copies.insert(original, copy);
+      this->originals.insert(copy, original);
+      this->created.push_back(copy);
+    }
+
+    return copy;
+  }
+
+  /// @brief Fills the neighbor list of `copy` from that of `original`.
+  void wire(Node* original, Node* copy) {
+    copy->neighbors.clear();
+    copy->neighbors.reserve(original->neighbors.size());
+
+    for (Node* neighbor : original->neighbors) {
+      copy->neighbors.push_back(this->copyOf(neighbor));
+    }
+  }
+
+  /// @brief The storage of every copy.
+  NodeArena arena;
+  /// @brief The copy of every original node copied so far.
+  NodeAddressTable copies;
+  /// @brief The original of every copy.
+  NodeAddressTable originals;
+  /// @brief The original of every copy whose neighbor list has been filled.
+  NodeAddressTable wired;
+  /// @brief Every copy, in creation order.
+  vector<Node*> created;
 };
\ No newline at end of file
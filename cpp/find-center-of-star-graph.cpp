@@ -1,47 +1,182 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
 #include <vector>
 
+using std::array;
+using std::size_t;
+using std::span;
 using std::vector;
 
+/// @brief A read-only view over edges stored as packed `[u, v]` pairs.
+///
+/// Every pair lives in one flat buffer, so the view can point straight at a
+/// `vector<array<int, 2>>` or at the body of a memory-mapped edge file.
+using PackedEdges = span<const array<int, 2>>;
+
+/// @brief Finds the node shared by two edges.
+/// @param firstLeft One endpoint of the first edge.
+/// @param firstRight The other endpoint of the first edge.
+/// @param secondLeft One endpoint of the second edge.
+/// @param secondRight The other endpoint of the second edge.
+/// @return The shared node, or -1 if the edges have no node in common.
+inline int sharedNode(int firstLeft, int firstRight, int secondLeft,
+                      int secondRight) {
+  if (firstLeft == secondLeft || firstLeft == secondRight) {
+    return firstLeft;
+  }
+
+  if (firstRight == secondLeft || firstRight == secondRight) {
+    return firstRight;
+  }
+
+  return -1;
+}
+
 /// @class Solution
 /// @brief A class that provides a solution to the "Find Center of Star Graph"
 /// problem.
 ///
 /// A star graph is a specific type of graph where one central node is connected
 /// to all other nodes, and there are no other connections. The solution
-/// leverages a key property of this graph structure: the center node is the
-/// only node with a degree (number of connections) equal to `n - 1`, where `n`
-/// is the total number of nodes.
+/// leverages a key property of this graph structure: since every edge touches
+/// the center, the center is the only node shared by any two edges.
 class Solution {
  public:
   /// @brief Finds the center of a star graph.
   ///
-  /// The method determines the number of connections for each node. In a star
-  /// graph, the central node will have a degree equal to `n - 1` (where `n` is
-  /// the number of nodes), while all other nodes will have a degree of 1. The
-  /// algorithm finds the node that satisfies this condition.
+  /// The method looks only at the first two edges. Both of them touch the
+  /// center, and no other node can appear in both, so their common node is the
+  /// answer. No memory is allocated and the rest of the edges are never read.
   ///
   /// @param edges A vector of vectors, where each inner vector represents an
   /// edge `[u, v]` connecting node `u` and `v`.
   /// @return The label of the center node. If no such node is found, returns
   /// -1.
   int findCenter(vector<vector<int>>& edges) {
-    const int n = edges.size() + 1;
-    vector<int> connectionsCount(n + 1, 0);
+    return this->firstSharedNode(edges);
+  }
+
+  /// @brief Finds the center of a star graph given as packed edges.
+  /// @param edges A view over the packed edges.
+  /// @return The label of the center node. If no such node is found, returns
+  /// -1.
+  int findCenter(PackedEdges edges) { return this->firstSharedNode(edges); }
+
+ private:
+  /// @brief Returns the node shared by the first two edges.
+  /// @tparam Edges Any sized range whose elements expose the endpoints as
+  /// `edge[0]` and `edge[1]`.
+  /// @param edges A constant reference to the edges.
+  /// @return The label of the center node, or -1 if there is none.
+  template <typename Edges>
+  int firstSharedNode(const Edges& edges) {
+    if (std::size(edges) < 2) {
+      return -1;
+    }
+
+    return sharedNode(edges[0][0], edges[0][1], edges[1][0], edges[1][1]);
+  }
+};
+
+/// @class StarGraphValidator
+/// @brief Checks that a stream of edges forms a star graph while it arrives.
+///
+/// The candidate center is fixed by the first two edges, and every later edge
+/// only has to touch it. The validator keeps a constant amount of state, reads
+/// each edge once and rejects the stream at the first edge that breaks the
+/// star shape. Because it stores no per-node data, it does not detect the same
+/// leaf being connected twice.
+class StarGraphValidator {
+ public:
+  /// @brief Feeds the next edge of the stream.
+  /// @param left One endpoint of the edge.
+  /// @param right The other endpoint of the edge.
+  /// @return `false` once the stream has been rejected, `true` otherwise.
+  bool accept(int left, int right) {
+    if (this->rejected) {
+      return false;
+    }
+
+    this->edgeCount++;
+
+    if (left == right) {
+      this->rejected = true;
+    } else if (this->edgeCount == 1) {
+      this->firstLeft = left;
+      this->firstRight = right;
+    } else if (this->edgeCount == 2) {
+      this->center = sharedNode(this->firstLeft, this->firstRight, left, right);
+      this->rejected = this->center == -1;
+    } else {
+      this->rejected = left != this->center && right != this->center;
+    }
+
+    return !this->rejected;
+  }
+
+  /// @brief Feeds a batch of packed edges.
+  ///
+  /// Edges before the center is known go through `accept`. The rest are
+  /// checked in blocks by a branch-free loop that the compiler vectorizes, so
+  /// the check costs a few SIMD compares per block instead of a branch per
+  /// edge. A rejection is noticed at the end of the block that contains it,
+  /// or at once if one of the first two edges breaks the star shape.
+  ///
+  /// @param edges A view over the packed edges.
+  /// @return `false` once the stream has been rejected, `true` otherwise.
+  bool accept(PackedEdges edges) {
+    size_t i = 0;
 
-    for (auto edge = edges.begin(); edge != edges.end(); edge++) {
-      const int left = edge->at(0);
-      const int right = edge->at(1);
+    while (i < edges.size() && this->edgeCount < 2 && !this->rejected) {
+      this->accept(edges[i][0], edges[i][1]);
+      i++;
+    }
+
+    while (i < edges.size() && !this->rejected) {
+      const size_t end = std::min(i + blockSize, edges.size());
 
-      connectionsCount[left]++;
-      connectionsCount[right]++;
+      this->rejected = this->countMisses(edges.subspan(i, end - i)) != 0;
+      this->edgeCount += end - i;
+      i = end;
     }
 
-    for (int i = 1; i <= n; i++) {
-      if (connectionsCount[i] == n - 1) {
-        return i;
-      }
+    return !this->rejected;
+  }
+
+  /// @brief Returns the center of the star, or -1 while it is still unknown or
+  /// if the stream was rejected.
+  int currentCenter() const { return this->rejected ? -1 : this->center; }
+
+  /// @brief Returns whether every edge fed so far fits a star graph.
+  bool valid() const { return !this->rejected; }
+
+ private:
+  /// @brief The number of edges checked between two rejection tests.
+  static constexpr size_t blockSize = 1024;
+
+  /// @brief Counts the edges of a block that do not touch the center or that
+  /// loop back on themselves.
+  int countMisses(PackedEdges block) const {
+    const int hub = this->center;
+    int misses = 0;
+
+    for (const array<int, 2>& edge : block) {
+      misses += ((edge[0] != hub) & (edge[1] != hub)) | (edge[0] == edge[1]);
     }
 
-    return -1;
+    return misses;
   }
+
+  /// @brief One endpoint of the first edge, kept until the second arrives.
+  int firstLeft = -1;
+  /// @brief The other endpoint of the first edge.
+  int firstRight = -1;
+  /// @brief The center of the star, known after the second edge.
+  int center = -1;
+  /// @brief The number of edges fed so far.
+  size_t edgeCount = 0;
+  /// @brief Whether some edge has broken the star shape.
+  bool rejected = false;
 };
\ No newline at end of file
@@ -1,59 +1,259 @@
-#include <queue>
-#include <unordered_set>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <thread>
+#include <utility>
 #include <vector>
 
-using std::queue;
-using std::unordered_set;
+using std::array;
+using std::atomic;
+using std::barrier;
+using std::function;
+using std::pair;
+using std::size_t;
+using std::span;
+using std::thread;
+using std::uint64_t;
 using std::vector;
 
-/// @brief A type alias for a graph's adjacency list representation.
+/// @brief A read-only view over edges stored as packed `[u, v]` pairs.
 ///
-/// The graph is represented as a vector where each index corresponds to a node,
-/// and the value is an `unordered_set` containing its neighbors.
-using AdjanceList = vector<unordered_set<int>>;
+/// The pairs sit back to back in a single buffer, so a view can wrap a
+/// `vector<array<int, 2>>` or a memory-mapped edge dump directly, without
+/// building one heap-allocated inner vector per edge.
+using PackedEdges = span<const array<int, 2>>;
 
-/// @class Solution
-/// @brief A class that provides a solution to the "Find if Path Exists in
-/// Graph" problem.
+/// @class CompressedGraph
+/// @brief An undirected graph stored in compressed sparse row (CSR) form.
 ///
-/// This solution uses a Breadth-First Search (BFS) algorithm to efficiently
-/// traverse the graph and determine if a path exists from the source to the
-/// destination.
-class Solution {
+/// The neighbors of every node live in one contiguous array, and `offsets[v]`
+/// and `offsets[v + 1]` delimit the neighbors of node `v`. The graph is built
+/// from an edge list in two counting passes and always performs exactly two
+/// allocations, no matter how many edges it holds.
+class CompressedGraph {
  public:
-  /// @brief Determines if a valid path exists between two nodes in a graph.
+  /// @brief Builds the graph from a list of undirected edges.
   ///
-  /// The method performs a BFS starting from the `source` node. It explores
-  /// the graph layer by layer, checking if the `destination` node is reachable.
+  /// The first pass counts the degree of every node and turns the counts into
+  /// end offsets with a running sum. The second pass scatters each endpoint
+  /// into its slot, walking the offsets backwards so that, once every edge is
+  /// placed, each offset points at the start of its node's neighbors.
   ///
+  /// @tparam Edges Any sized range whose elements expose the endpoints as
+  /// `edge[0]` and `edge[1]`, such as `vector<vector<int>>` or `PackedEdges`.
   /// @param n The number of nodes in the graph.
-  /// @param edges A constant reference to a vector of edges, where each edge is
-  /// a pair of connected nodes.
+  /// @param edges A constant reference to the edges.
+  template <typename Edges>
+  CompressedGraph(int n, const Edges& edges)
+      : offsets(n + 1, 0), neighbors(2 * std::size(edges)) {
+    for (const auto& edge : edges) {
+      this->offsets[edge[0]]++;
+      this->offsets[edge[1]]++;
+    }
+
+    for (int node = 1; node <= n; node++) {
+      this->offsets[node] += this->offsets[node - 1];
+    }
+
+    for (const auto& edge : edges) {
+      const int left = edge[0];
+      const int right = edge[1];
+
+      this->neighbors[--this->offsets[left]] = right;
+      this->neighbors[--this->offsets[right]] = left;
+    }
+  }
+
+  /// @brief Returns the number of nodes in the graph.
+  int size() const { return static_cast<int>(this->offsets.size()) - 1; }
+
+  /// @brief Returns the number of neighbor entries, twice the edge count.
+  size_t edgeSlots() const { return this->neighbors.size(); }
+
+  /// @brief Returns the neighbors of a node as a view over the shared array.
+  /// @param node The node whose neighbors are requested.
+  /// @return A read-only view of the neighbors of `node`.
+  span<const int> neighborsOf(int node) const {
+    const int* begin = this->neighbors.data() + this->offsets[node];
+    const int* end = this->neighbors.data() + this->offsets[node + 1];
+
+    return span<const int>(begin, end);
+  }
+
+ private:
+  /// @brief The start of each node's neighbors, plus the total at the end.
+  vector<size_t> offsets;
+  /// @brief The neighbors of every node, stored back to back.
+  vector<int> neighbors;
+};
+
+/// @class NodeBitset
+/// @brief A dense set of node ids that spends one bit per node.
+///
+/// Node ids are dense in `[0, n)`, so membership is a shift and a mask instead
+/// of a hash lookup, and clearing the whole set is a single `memset`-like fill.
+class NodeBitset {
+ public:
+  /// @brief Creates an empty set able to hold the ids `[0, n)`.
+  /// @param n The number of possible node ids.
+  explicit NodeBitset(int n) : words((n + 63) / 64, 0) {}
+
+  /// @brief Checks whether a node is in the set.
+  bool contains(int node) const {
+    return (this->words[node >> 6] >> (node & 63)) & 1;
+  }
+
+  /// @brief Adds a node to the set.
+  void insert(int node) { this->words[node >> 6] |= uint64_t{1} << (node & 63); }
+
+  /// @brief Removes every node from the set.
+  void clear() { std::fill(this->words.begin(), this->words.end(), 0); }
+
+ private:
+  /// @brief The membership bits, 64 nodes per word.
+  vector<uint64_t> words;
+};
+
+/// @class FrontierSearch
+/// @brief A reusable reachability engine that runs a direction-optimizing BFS
+/// over a `CompressedGraph`.
+///
+/// Each level is expanded either top-down, walking the edges of the frontier,
+/// or bottom-up, letting every unvisited node look for a parent in the
+/// frontier. The engine switches to bottom-up once the frontier touches more
+/// edges than `1 / alpha` of the unexplored ones, and back to top-down once the
+/// frontier holds fewer than `1 / beta` of the nodes (Beamer et al.).
+///
+/// In bidirectional mode a second search grows from `destination`; at every
+/// level the side with the cheaper frontier advances, and the query stops as
+/// soon as one side reaches a node the other side has already visited.
+class FrontierSearch {
+ public:
+  /// @brief Prepares the engine for queries over `graph`.
+  ///
+  /// The visited sets and frontiers are allocated once here and reused by
+  /// every query.
+  ///
+  /// @param graph The graph to search. It must outlive the engine.
+  /// @param bidirectional Whether to search from both endpoints at once.
+  explicit FrontierSearch(const CompressedGraph& graph,
+                          bool bidirectional = true)
+      : graph(graph),
+        bidirectional(bidirectional),
+        forward(graph.size()),
+        backward(graph.size()) {}
+
+  /// @brief Determines if `destination` is reachable from `source`.
   /// @param source The starting node of the path.
   /// @param destination The target node of the path.
   /// @return `true` if a path exists from source to destination, `false`
   /// otherwise.
-  bool validPath(int n, const vector<vector<int>>& edges, int source,
-                 int destination) const {
-    AdjanceList adjanceList = this->toAdjanceList(n, edges);
+  bool connects(int source, int destination) {
+    this->edgesExamined = 0;
 
-    unordered_set<int> seens;
-    queue<int> toVisit({source});
+    this->reset(this->forward, source);
+    this->reset(this->backward, destination);
 
-    while (!toVisit.empty()) {
-      int current = toVisit.front();
-      toVisit.pop();
+    if (source == destination) {
+      return true;
+    }
 
-      if (current == destination) {
+    while (!this->forward.frontier.empty() &&
+           !this->backward.frontier.empty()) {
+      const bool backwardIsCheaper =
+          this->backward.frontierEdges < this->forward.frontierEdges;
+
+      Side& advancing = this->bidirectional && backwardIsCheaper
+                            ? this->backward
+                            : this->forward;
+      Side& waiting =
+          &advancing == &this->forward ? this->backward : this->forward;
+
+      if (this->advance(advancing, waiting)) {
         return true;
       }
+    }
+
+    return false;
+  }
+
+  /// @brief Returns how many edges the last call to `connects` examined.
+  size_t lastEdgesExamined() const { return this->edgesExamined; }
+
+ private:
+  /// @brief Switch to bottom-up when frontier edges exceed unexplored / alpha.
+  static constexpr size_t alpha = 14;
+  /// @brief Switch back to top-down when the frontier drops below n / beta.
+  static constexpr size_t beta = 24;
+
+  /// @brief The state of the search growing from one endpoint.
+  struct Side {
+    explicit Side(int n) : visited(n), inFrontier(n) {}
+
+    /// @brief Every node this side has reached.
+    NodeBitset visited;
+    /// @brief The current frontier as a bitset, filled for bottom-up levels.
+    NodeBitset inFrontier;
+    /// @brief The current frontier as a list of nodes.
+    vector<int> frontier;
+    /// @brief The frontier being built by the level in progress.
+    vector<int> next;
+    /// @brief The sum of the degrees of the frontier nodes.
+    size_t frontierEdges = 0;
+    /// @brief The sum of the degrees of the nodes not yet visited.
+    size_t unexploredEdges = 0;
+    /// @brief Whether the side is currently expanding bottom-up.
+    bool bottomUp = false;
+  };
+
+  /// @brief Restarts a side so that its frontier holds only `start`.
+  void reset(Side& side, int start) const {
+    const size_t startEdges = this->graph.neighborsOf(start).size();
+
+    side.visited.clear();
+    side.visited.insert(start);
+    side.frontier.assign({start});
+    side.frontierEdges = startEdges;
+    side.unexploredEdges = this->graph.edgeSlots() - startEdges;
+    side.bottomUp = false;
+  }
+
+  /// @brief Expands one level of `side`, picking the cheaper direction.
+  /// @return `true` if the level reached a node visited by `other`.
+  bool advance(Side& side, const Side& other) {
+    const size_t n = this->graph.size();
+
+    if (!side.bottomUp && side.frontierEdges > side.unexploredEdges / alpha) {
+      side.bottomUp = true;
+    } else if (side.bottomUp && side.frontier.size() < n / beta) {
+      side.bottomUp = false;
+    }
 
-      seens.insert(current);
+    side.next.clear();
+    side.frontierEdges = 0;
 
-      for (auto node : adjanceList[current]) {
-        if (!this->setContains(seens, node)) {
-          seens.insert(node);
-          toVisit.push(node);
+    const bool met = side.bottomUp ? this->stepBottomUp(side, other)
+                                   : this->stepTopDown(side, other);
+
+    side.frontier.swap(side.next);
+
+    return met;
+  }
+
+  /// @brief Expands a level by scanning the edges of every frontier node.
+  bool stepTopDown(Side& side, const Side& other) {
+    for (int current : side.frontier) {
+      const span<const int> neighbors = this->graph.neighborsOf(current);
+      this->edgesExamined += neighbors.size();
+
+      for (int node : neighbors) {
+        if (!side.visited.contains(node) && this->visit(side, other, node)) {
+          return true;
         }
       }
     }
@@ -61,40 +261,609 @@ class Solution {
     return false;
   }
 
- private:
-  /// @brief Converts a list of edges into an adjacency list representation of
-  /// the graph.
+  /// @brief Expands a level by letting every unvisited node search its
+  /// neighbors for a parent in the frontier.
+  bool stepBottomUp(Side& side, const Side& other) {
+    side.inFrontier.clear();
+
+    for (int node : side.frontier) {
+      side.inFrontier.insert(node);
+    }
+
+    for (int node = 0; node < this->graph.size(); node++) {
+      if (side.visited.contains(node)) {
+        continue;
+      }
+
+      for (int parent : this->graph.neighborsOf(node)) {
+        this->edgesExamined++;
+
+        if (side.inFrontier.contains(parent)) {
+          if (this->visit(side, other, node)) {
+            return true;
+          }
+
+          break;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  /// @brief Marks `node` as reached by `side` and queues it for the next level.
+  /// @return `true` if `other` has already reached `node`.
+  bool visit(Side& side, const Side& other, int node) const {
+    const size_t degree = this->graph.neighborsOf(node).size();
+
+    side.visited.insert(node);
+    side.next.push_back(node);
+    side.frontierEdges += degree;
+    side.unexploredEdges -= degree;
+
+    return other.visited.contains(node);
+  }
+
+  /// @brief The graph being searched.
+  const CompressedGraph& graph;
+  /// @brief Whether the search also grows from the destination.
+  bool bidirectional;
+  /// @brief The search growing from the source.
+  Side forward;
+  /// @brief The search growing from the destination.
+  Side backward;
+  /// @brief The number of edges examined by the query in progress.
+  size_t edgesExamined = 0;
+};
+
+/// @class ParallelFrontierSearch
+/// @brief A reachability engine that runs a level-synchronous BFS on several
+/// threads.
+///
+/// At every level the workers claim chunks of the frontier through a shared
+/// cursor, mark the nodes they reach in an atomic bitset, so that each node is
+/// claimed by exactly one worker, and collect them into per-worker lists. A
+/// barrier closes the level and merges those lists into the next frontier. As
+/// soon as any worker reaches `destination` it raises a flag. Every worker
+/// tests it before each frontier node it expands, so the others stop within
+/// one node's neighbor list rather than at the end of their chunk.
+///
+/// The worker threads are started once by the constructor and sleep on a
+/// barrier between queries, so a query pays for no thread creation.
+class ParallelFrontierSearch {
+ public:
+  /// @brief Prepares the engine for queries over `graph` and starts its
+  /// workers.
+  ///
+  /// @param graph The graph to search. It must outlive the engine.
+  /// @param threads The number of workers, including the calling thread. Zero
+  /// picks one worker per hardware thread.
+  /// @param ordered Whether to sort each merged frontier. The nodes of a level
+  /// are always those of the same level of a serial BFS, but the order in
+  /// which the workers reach them varies from run to run; sorted, the levels
+  /// passed to `forEachLevel` are identical whatever the number of workers
+  /// and however they were scheduled.
+  explicit ParallelFrontierSearch(const CompressedGraph& graph,
+                                  unsigned threads = 0, bool ordered = false)
+      : graph(graph),
+        threads(threads != 0 ? threads
+                             : std::max(1u, thread::hardware_concurrency())),
+        ordered(ordered),
+        visited((graph.size() + 63) / 64),
+        nexts(this->threads),
+        queryStart(this->threads, QueryStart{this}),
+        levelEnd(this->threads, LevelMerge{this}) {
+    for (unsigned worker = 1; worker < this->threads; worker++) {
+      this->workers.emplace_back([this, worker]() { this->serve(worker); });
+    }
+  }
+
+  ParallelFrontierSearch(const ParallelFrontierSearch&) = delete;
+  ParallelFrontierSearch& operator=(const ParallelFrontierSearch&) = delete;
+
+  /// @brief Stops and joins the workers.
+  ~ParallelFrontierSearch() {
+    this->stopping = true;
+    this->queryStart.arrive_and_wait();
+
+    for (thread& worker : this->workers) {
+      worker.join();
+    }
+  }
+
+  /// @brief Determines if `destination` is reachable from `source`.
+  /// @param source The starting node of the path.
+  /// @param destination The target node of the path.
+  /// @return `true` if a path exists from source to destination, `false`
+  /// otherwise.
+  bool connects(int source, int destination) {
+    if (source == destination) {
+      return true;
+    }
+
+    this->search(source, destination);
+
+    return this->found.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Runs a full BFS from `source` and hands every level to `visit`,
+  /// starting with `{source}` itself.
   ///
-  /// The adjacency list is a more suitable data structure for graph traversal
-  /// algorithms like BFS. It represents the graph as a collection of lists,
-  /// where each list contains the neighbors of a specific node.
+  /// `visit` runs on one thread while the workers wait between two levels,
+  /// so it must not throw, and the view it receives is only valid until it
+  /// returns.
   ///
+  /// @tparam Visitor A callable taking a `span<const int>`.
+  /// @param source The node the search starts from.
+  /// @param visit The consumer of the levels, called once per level, in
+  /// order.
+  template <typename Visitor>
+  void forEachLevel(int source, Visitor&& visit) {
+    const int start[] = {source};
+    visit(span<const int>(start));
+
+    this->levelSink = [&visit](span<const int> level) { visit(level); };
+    this->search(source, -1);
+    this->levelSink = nullptr;
+  }
+
+ private:
+  /// @brief The number of frontier nodes a worker claims at a time.
+  static constexpr size_t chunkSize = 256;
+
+  /// @brief The completion step of the query barrier. `done` is only reset
+  /// here, once every worker has read it at the end of the previous search.
+  struct QueryStart {
+    ParallelFrontierSearch* search;
+
+    void operator()() noexcept { this->search->done = false; }
+  };
+
+  /// @brief The completion step of the level barrier.
+  struct LevelMerge {
+    ParallelFrontierSearch* search;
+
+    void operator()() noexcept { this->search->mergeLevel(); }
+  };
+
+  /// @brief Resets the search state and runs one search with every worker,
+  /// returning once the last level has been merged.
+  void search(int source, int destination) {
+    for (atomic<uint64_t>& word : this->visited) {
+      word.store(0, std::memory_order_relaxed);
+    }
+
+    this->claim(source);
+    this->frontier.assign({source});
+    this->cursor.store(0, std::memory_order_relaxed);
+    this->found.store(false, std::memory_order_relaxed);
+    this->destination = destination;
+
+    this->queryStart.arrive_and_wait();
+    this->work(0);
+  }
+
+  /// @brief The loop of a worker thread: one search per query, until the
+  /// engine is destroyed.
+  void serve(unsigned worker) {
+    while (true) {
+      this->queryStart.arrive_and_wait();
+
+      if (this->stopping) {
+        return;
+      }
+
+      this->work(worker);
+    }
+  }
+
+  /// @brief The level loop run by every worker until the search is over.
+  void work(unsigned worker) {
+    while (true) {
+      this->expandChunks(this->nexts[worker]);
+      this->levelEnd.arrive_and_wait();
+
+      if (this->done) {
+        return;
+      }
+    }
+  }
+
+  /// @brief Claims frontier chunks until the level is exhausted or the
+  /// destination is found.
+  void expandChunks(vector<int>& next) {
+    const size_t frontierSize = this->frontier.size();
+
+    while (!this->found.load(std::memory_order_relaxed)) {
+      const size_t begin =
+          this->cursor.fetch_add(chunkSize, std::memory_order_relaxed);
+
+      if (begin >= frontierSize) {
+        return;
+      }
+
+      const size_t end = std::min(begin + chunkSize, frontierSize);
+
+      for (size_t i = begin; i < end; i++) {
+        if (this->found.load(std::memory_order_relaxed)) {
+          return;
+        }
+
+        for (int node : this->graph.neighborsOf(this->frontier[i])) {
+          if (node == this->destination) {
+            this->found.store(true, std::memory_order_relaxed);
+            return;
+          }
+
+          if (this->claim(node)) {
+            next.push_back(node);
+          }
+        }
+      }
+    }
+  }
+
+  /// @brief Marks `node` as visited.
+  /// @return `true` if this call was the one that marked it.
+  bool claim(int node) {
+    atomic<uint64_t>& word = this->visited[node >> 6];
+    const uint64_t bit = uint64_t{1} << (node & 63);
+
+    if (word.load(std::memory_order_relaxed) & bit) {
+      return false;
+    }
+
+    return (word.fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+  }
+
+  /// @brief Closes a level: gathers the per-worker lists into the next
+  /// frontier, hands it to the level sink if there is one, and decides
+  /// whether the search goes on. It runs on a single thread while every
+  /// worker waits on the barrier.
+  void mergeLevel() {
+    this->frontier.clear();
+
+    for (vector<int>& next : this->nexts) {
+      this->frontier.insert(this->frontier.end(), next.begin(), next.end());
+      next.clear();
+    }
+
+    if (this->ordered) {
+      std::sort(this->frontier.begin(), this->frontier.end());
+    }
+
+    if (this->levelSink && !this->frontier.empty()) {
+      this->levelSink(this->frontier);
+    }
+
+    this->cursor.store(0, std::memory_order_relaxed);
+    this->done =
+        this->found.load(std::memory_order_relaxed) || this->frontier.empty();
+  }
+
+  /// @brief The graph being searched.
+  const CompressedGraph& graph;
+  /// @brief The number of workers, including the calling thread.
+  unsigned threads;
+  /// @brief Whether merged frontiers are sorted.
+  bool ordered;
+  /// @brief The visited bits, 64 nodes per word.
+  vector<atomic<uint64_t>> visited;
+  /// @brief The nodes reached by each worker during the current level.
+  vector<vector<int>> nexts;
+  /// @brief The frontier of the current level.
+  vector<int> frontier;
+  /// @brief The index of the next frontier chunk to hand out.
+  atomic<size_t> cursor = 0;
+  /// @brief Whether some worker has reached the destination.
+  atomic<bool> found = false;
+  /// @brief Whether the search is over, written only by barrier completions.
+  bool done = false;
+  /// @brief The node the current search looks for, or -1 for none.
+  int destination = -1;
+  /// @brief The consumer of the levels of `forEachLevel`, if one is running.
+  function<void(span<const int>)> levelSink;
+  /// @brief Whether the workers must exit, set by the destructor.
+  bool stopping = false;
+  /// @brief Releases the workers into a new search, or into shutdown.
+  barrier<QueryStart> queryStart;
+  /// @brief Closes every level of a search.
+  barrier<LevelMerge> levelEnd;
+  /// @brief The worker threads, all but the calling one.
+  vector<thread> workers;
+};
+
+/// @class ConnectivityIndex
+/// @brief A persistent index that answers reachability queries over a graph
+/// whose edge set only grows.
+///
+/// The index is a union-find (disjoint-set) structure with union by rank and
+/// path compression, so adding an edge and asking whether two nodes are
+/// connected both take near-constant amortized time. Edges are folded in once,
+/// and no query ever revisits the edge list.
+class ConnectivityIndex {
+ public:
+  /// @brief Creates an index over `n` nodes with no edges.
   /// @param n The number of nodes in the graph.
-  /// @param edges A constant reference to the vector of edges.
-  /// @return An adjacency list representing the graph.
-  AdjanceList toAdjanceList(int n, const vector<vector<int>>& edges) const {
-    AdjanceList adjanceList(n);
+  explicit ConnectivityIndex(int n) : parents(n), ranks(n, 0) {
+    for (int node = 0; node < n; node++) {
+      this->parents[node] = node;
+    }
+  }
+
+  /// @brief Creates an index over `n` nodes that already holds `edges`.
+  /// @tparam Edges Any range whose elements expose the endpoints as `edge[0]`
+  /// and `edge[1]`.
+  /// @param n The number of nodes in the graph.
+  /// @param edges A constant reference to the edges.
+  template <typename Edges>
+  ConnectivityIndex(int n, const Edges& edges)
+      : ConnectivityIndex(n) {
+    this->addEdges(edges);
+  }
+
+  /// @brief Adds an undirected edge, merging the components of its endpoints.
+  /// @param left One endpoint of the edge.
+  /// @param right The other endpoint of the edge.
+  void addEdge(int left, int right) {
+    int leftRoot = this->find(left);
+    int rightRoot = this->find(right);
+
+    if (leftRoot == rightRoot) {
+      return;
+    }
+
+    if (this->ranks[leftRoot] < this->ranks[rightRoot]) {
+      std::swap(leftRoot, rightRoot);
+    }
+
+    this->parents[rightRoot] = leftRoot;
+
+    if (this->ranks[leftRoot] == this->ranks[rightRoot]) {
+      this->ranks[leftRoot]++;
+    }
+  }
+
+  /// @brief Adds a batch of undirected edges.
+  /// @tparam Edges Any range whose elements expose the endpoints as `edge[0]`
+  /// and `edge[1]`.
+  /// @param edges A constant reference to the edges.
+  template <typename Edges>
+  void addEdges(const Edges& edges) {
+    for (const auto& edge : edges) {
+      this->addEdge(edge[0], edge[1]);
+    }
+  }
+
+  /// @brief Determines if two nodes belong to the same component.
+  /// @param source The starting node of the path.
+  /// @param destination The target node of the path.
+  /// @return `true` if a path exists from source to destination, `false`
+  /// otherwise.
+  bool connected(int source, int destination) {
+    return this->find(source) == this->find(destination);
+  }
+
+  /// @brief Answers a batch of queries stored back to back in one array.
+  /// @param queries The `(source, destination)` pairs to check.
+  /// @return One flag per query, `true` where the pair is connected.
+  vector<bool> connected(span<const pair<int, int>> queries) {
+    vector<bool> answers(queries.size());
+
+    for (size_t i = 0; i < queries.size(); i++) {
+      answers[i] = this->connected(queries[i].first, queries[i].second);
+    }
+
+    return answers;
+  }
+
+ private:
+  /// @brief Finds the root of a node's component.
+  ///
+  /// After walking up to the root, the method makes every node on the walked
+  /// path point straight at it, so later lookups take a single hop.
+  ///
+  /// @param node The node whose component is requested.
+  /// @return The node that represents the component.
+  int find(int node) {
+    int root = node;
+
+    while (this->parents[root] != root) {
+      root = this->parents[root];
+    }
+
+    while (this->parents[node] != root) {
+      const int parent = this->parents[node];
+      this->parents[node] = root;
+      node = parent;
+    }
+
+    return root;
+  }
+
+  /// @brief The parent of each node; roots are their own parent.
+  vector<int> parents;
+  /// @brief An upper bound on the height of the tree under each root.
+  vector<int> ranks;
+};
+
+/// @class MultiSourceReachability
+/// @brief Answers batches of reachability queries with a bit-parallel
+/// multi-source BFS (MS-BFS).
+///
+/// Up to 64 queries run together. Every node keeps one 64-bit word of "seen"
+/// bits and one of frontier bits, bit `i` belonging to query `i`, so a single
+/// scan of a node's neighbors advances every search that has reached it.
+/// Sources that share parts of the graph therefore share the adjacency scans.
+class MultiSourceReachability {
+ public:
+  /// @brief Prepares the engine for queries over `graph`.
+  ///
+  /// The per-node words are allocated once here and reused by every batch.
+  ///
+  /// @param graph The graph to search. It must outlive the engine.
+  explicit MultiSourceReachability(const CompressedGraph& graph)
+      : graph(graph),
+        seen(graph.size(), 0),
+        frontier(graph.size(), 0),
+        next(graph.size(), 0) {}
+
+  /// @brief Determines, for every query, if its destination is reachable from
+  /// its source.
+  /// @param queries The `(source, destination)` pairs to check.
+  /// @return A bitmap with bit `i % 64` of word `i / 64` set when query `i`
+  /// is connected.
+  vector<uint64_t> reachable(span<const pair<int, int>> queries) {
+    vector<uint64_t> answers((queries.size() + 63) / 64, 0);
+
+    for (size_t begin = 0; begin < queries.size(); begin += 64) {
+      const size_t count = std::min<size_t>(64, queries.size() - begin);
+      answers[begin / 64] = this->searchWord(queries.subspan(begin, count));
+    }
+
+    return answers;
+  }
+
+ private:
+  /// @brief Runs up to 64 queries at once.
+  /// @return The answers of the queries, one bit each.
+  uint64_t searchWord(span<const pair<int, int>> queries) {
+    std::fill(this->seen.begin(), this->seen.end(), 0);
+    this->active.clear();
+
+    for (size_t i = 0; i < queries.size(); i++) {
+      const int source = queries[i].first;
+
+      if (this->frontier[source] == 0) {
+        this->active.push_back(source);
+      }
+
+      this->seen[source] |= uint64_t{1} << i;
+      this->frontier[source] |= uint64_t{1} << i;
+    }
+
+    uint64_t answered = this->answeredBits(queries);
+    const uint64_t all = queries.size() == 64
+                             ? ~uint64_t{0}
+                             : (uint64_t{1} << queries.size()) - 1;
+
+    while (!this->active.empty() && answered != all) {
+      this->nextActive.clear();
+
+      for (int node : this->active) {
+        const uint64_t bits = this->frontier[node];
+        this->frontier[node] = 0;
+
+        for (int neighbor : this->graph.neighborsOf(node)) {
+          const uint64_t fresh = bits & ~this->seen[neighbor];
 
-    for (auto edge : edges) {
-      const int left = edge.at(0);
-      const int right = edge.at(1);
+          if (fresh == 0) {
+            continue;
+          }
 
-      adjanceList[left].insert(right);
-      adjanceList[right].insert(left);
+          if (this->next[neighbor] == 0) {
+            this->nextActive.push_back(neighbor);
+          }
+
+          this->next[neighbor] |= fresh;
+          this->seen[neighbor] |= fresh;
+        }
+      }
+
+      for (int node : this->nextActive) {
+        this->frontier[node] = std::exchange(this->next[node], 0);
+      }
+
+      this->active.swap(this->nextActive);
+      answered = this->answeredBits(queries);
+    }
+
+    for (int node : this->active) {
+      this->frontier[node] = 0;
     }
 
-    return adjanceList;
+    return answered;
+  }
+
+  /// @brief Returns the bits of the queries whose destination has been seen.
+  uint64_t answeredBits(span<const pair<int, int>> queries) const {
+    uint64_t answered = 0;
+
+    for (size_t i = 0; i < queries.size(); i++) {
+      answered |= this->seen[queries[i].second] & (uint64_t{1} << i);
+    }
+
+    return answered;
+  }
+
+  /// @brief The graph being searched.
+  const CompressedGraph& graph;
+  /// @brief The queries that have reached each node.
+  vector<uint64_t> seen;
+  /// @brief The queries for which each node is in the current frontier.
+  vector<uint64_t> frontier;
+  /// @brief The queries for which each node joins the next frontier.
+  vector<uint64_t> next;
+  /// @brief The nodes with a non-empty frontier word.
+  vector<int> active;
+  /// @brief The nodes with a non-empty next word.
+  vector<int> nextActive;
+};
+
+/// @class Solution
+/// @brief A class that provides a solution to the "Find if Path Exists in
+/// Graph" problem.
+///
+/// This solution uses a Breadth-First Search (BFS) algorithm to efficiently
+/// traverse the graph and determine if a path exists from the source to the
+/// destination.
+class Solution {
+ public:
+  /// @brief Determines if a valid path exists between two nodes in a graph.
+  ///
+  /// The method converts the edge list into a `CompressedGraph` and runs the
+  /// search on it.
+  ///
+  /// @param n The number of nodes in the graph.
+  /// @param edges A constant reference to a vector of edges, where each edge is
+  /// a pair of connected nodes.
+  /// @param source The starting node of the path.
+  /// @param destination The target node of the path.
+  /// @return `true` if a path exists from source to destination, `false`
+  /// otherwise.
+  bool validPath(int n, const vector<vector<int>>& edges, int source,
+                 int destination) const {
+    return this->validPath(CompressedGraph(n, edges), source, destination);
+  }
+
+  /// @brief Determines if a valid path exists between two nodes of a graph
+  /// given as packed edges.
+  ///
+  /// @param n The number of nodes in the graph.
+  /// @param edges A view over the packed edges; nothing is copied out of it
+  /// other than the graph itself.
+  /// @param source The starting node of the path.
+  /// @param destination The target node of the path.
+  /// @return `true` if a path exists from source to destination, `false`
+  /// otherwise.
+  bool validPath(int n, PackedEdges edges, int source, int destination) const {
+    return this->validPath(CompressedGraph(n, edges), source, destination);
   }
 
-  /// @brief Checks if an element exists within an `unordered_set`.
+  /// @brief Determines if a valid path exists between two nodes of an already
+  /// built graph.
   ///
-  /// This is a helper function to provide clarity to the main algorithm.
-  /// @tparam T The type of the elements in the set.
-  /// @param st The `unordered_set` to search within.
-  /// @param element The element to find.
-  /// @return `true` if the element is in the set, `false` otherwise.
-  template <typename T>
-  bool setContains(const unordered_set<T>& st, T element) const {
-    return st.find(element) != st.end();
+  /// The method runs a bidirectional, direction-optimizing BFS through a
+  /// `FrontierSearch`. Building the graph once and calling this overload avoids
+  /// converting the edge list on every query.
+  ///
+  /// @param graph The graph to search.
+  /// @param source The starting node of the path.
+  /// @param destination The target node of the path.
+  /// @return `true` if a path exists from source to destination, `false`
+  /// otherwise.
+  bool validPath(const CompressedGraph& graph, int source,
+                 int destination) const {
+    return FrontierSearch(graph).connects(source, destination);
   }
 };
\ No newline at end of file
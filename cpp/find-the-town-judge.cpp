@@ -1,9 +1,44 @@
-#include <set>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <thread>
 #include <vector>
 
-using std::set;
+using std::array;
+using std::size_t;
+using std::span;
+using std::thread;
 using std::vector;
 
+/// @brief A read-only view over trust relationships stored as packed `[a, b]`
+/// pairs.
+///
+/// The pairs are laid out contiguously, which lets the view wrap a
+/// `vector<array<int, 2>>` or a memory-mapped dump of the trust graph as is.
+using PackedEdges = span<const array<int, 2>>;
+
+/// @brief Finds the person whose trust balance marks them as the Judge.
+///
+/// A person's balance is how many people trust them minus how many people they
+/// trust. As long as no pair is repeated, only the Judge reaches `n - 1`: it
+/// takes being trusted by everyone else and trusting nobody. The scan is a
+/// branch-free max-reduction, which the compiler vectorizes.
+///
+/// @param n The total number of people in the town.
+/// @param balance The balance of every person, indexed by label; index 0 is
+/// unused.
+/// @return The label of the Town Judge if one exists, otherwise returns -1.
+inline int judgeByBalance(int n, span<const int> balance) {
+  int judge = 0;
+
+  for (int person = 1; person <= n; person++) {
+    judge = std::max(judge, balance[person] == n - 1 ? person : 0);
+  }
+
+  return judge != 0 ? judge : -1;
+}
+
 /// @class Solution
 /// @brief A class that provides a solution to the "Find the Town Judge"
 /// problem.
@@ -14,10 +49,9 @@ class Solution {
  public:
   /// @brief Finds the Town Judge from a list of trust relationships.
   ///
-  /// This method iterates through the trust relationships to first identify
-  /// all individuals who trust someone else and to count how many people trust
-  /// each individual. It then checks each person against the two criteria
-  /// for being the Judge.
+  /// This method makes a single pass over the trust relationships, keeping
+  /// one balance per person: every trust received adds one, every trust given
+  /// takes one away. It then looks for the person whose balance is `n - 1`.
   ///
   /// The Judge is defined as the person who:
   /// 1. Trusts nobody.
@@ -28,26 +62,176 @@ class Solution {
   /// indicates that person `a` trusts person `b`.
   /// @return The label of the Town Judge if one exists, otherwise returns -1.
   int findJudge(int n, vector<vector<int>>& trust) {
-    set<int> trustInSomeOne;
-    vector<int> isTrustedBy(n, 0);
+    return this->balanceJudge(n, trust);
+  }
 
-    for (auto current = trust.begin(); current != trust.end(); current++) {
-      const int truster = current->at(0);
-      const int trusted = current->at(1);
+  /// @brief Finds the Town Judge from trust relationships given as packed
+  /// pairs.
+  /// @param n The total number of people in the town, labeled from 1 to `n`.
+  /// @param trust A view over the packed `[a, b]` pairs.
+  /// @return The label of the Town Judge if one exists, otherwise returns -1.
+  int findJudge(int n, PackedEdges trust) {
+    return this->balanceJudge(n, trust);
+  }
+
+ private:
+  /// @brief Accumulates the trust balance of every person and finds the
+  /// Judge among them.
+  /// @tparam Edges Any range whose elements expose the truster as `edge[0]`
+  /// and the trusted person as `edge[1]`.
+  /// @param n The total number of people in the town.
+  /// @param trust A constant reference to the trust relationships.
+  /// @return The label of the Town Judge if one exists, otherwise returns -1.
+  template <typename Edges>
+  int balanceJudge(int n, const Edges& trust) {
+    vector<int> balance(n + 1, 0);
 
-      trustInSomeOne.insert(truster);
-      isTrustedBy[trusted - 1]++;
+    for (const auto& current : trust) {
+      balance[current[0]]--;
+      balance[current[1]]++;
     }
 
-    for (int i = 0; i < n; i++) {
-      const int person = i + 1;
+    return judgeByBalance(n, balance);
+  }
+};
+
+/// @class ParallelJudgeFinder
+/// @brief Finds the Town Judge of very large trust graphs on several threads.
+///
+/// Every worker folds a contiguous slice of the trust pairs into its own
+/// balance histogram, so the edge pass needs no synchronization. The
+/// histograms are then summed by the same workers, each over a disjoint range
+/// of people, and the merged balance goes through the vectorized scan.
+class ParallelJudgeFinder {
+ public:
+  /// @brief Creates a finder that runs on the given number of threads.
+  /// @param threads The number of workers, including the calling thread. Zero
+  /// picks one worker per hardware thread.
+  explicit ParallelJudgeFinder(unsigned threads = 0)
+      : threads(threads != 0 ? threads
+                             : std::max(1u, thread::hardware_concurrency())) {}
+
+  /// @brief Finds the Town Judge from trust relationships given as packed
+  /// pairs.
+  /// @param n The total number of people in the town, labeled from 1 to `n`.
+  /// @param trust A view over the packed `[a, b]` pairs.
+  /// @return The label of the Town Judge if one exists, otherwise returns -1.
+  int findJudge(int n, PackedEdges trust) const {
+    const size_t people = n + 1;
+    vector<vector<int>> histograms(this->threads);
 
-      if (trustInSomeOne.find(person) == trustInSomeOne.end() &&
-          isTrustedBy.at(i) == n - 1) {
-        return person;
+    this->runWorkers([&](unsigned worker) {
+      const size_t begin = trust.size() * worker / this->threads;
+      const size_t end = trust.size() * (worker + 1) / this->threads;
+      vector<int>& balance = histograms[worker];
+
+      balance.assign(people, 0);
+
+      for (size_t i = begin; i < end; i++) {
+        balance[trust[i][0]]--;
+        balance[trust[i][1]]++;
       }
+    });
+
+    vector<int>& merged = histograms[0];
+
+    this->runWorkers([&](unsigned worker) {
+      const size_t begin = people * worker / this->threads;
+      const size_t end = people * (worker + 1) / this->threads;
+
+      for (unsigned other = 1; other < this->threads; other++) {
+        const vector<int>& balance = histograms[other];
+
+        for (size_t person = begin; person < end; person++) {
+          merged[person] += balance[person];
+        }
+      }
+    });
+
+    return judgeByBalance(n, merged);
+  }
+
+ private:
+  /// @brief Runs `task(worker)` on every worker and waits for all of them.
+  template <typename Task>
+  void runWorkers(const Task& task) const {
+    vector<thread> workers;
+
+    for (unsigned worker = 1; worker < this->threads; worker++) {
+      workers.emplace_back(task, worker);
+    }
+
+    task(0);
+
+    for (thread& worker : workers) {
+      worker.join();
+    }
+  }
+
+  /// @brief The number of workers.
+  unsigned threads;
+};
+
+/// @class JudgeTracker
+/// @brief Keeps track of the Town Judge while trust relationships keep
+/// arriving.
+///
+/// The tracker holds the same per-person balance as `Solution`, but updates it
+/// one relationship at a time. Since at most one person can have a balance of
+/// `n - 1`, only the two people touched by a new relationship can become or
+/// stop being the Judge, so each relationship costs O(1) work and the current
+/// Judge is always known without rescanning anyone.
+class JudgeTracker {
+ public:
+  /// @brief Creates a tracker for a town with no trust relationships yet.
+  /// @param n The total number of people in the town, labeled from 1 to `n`.
+  explicit JudgeTracker(int n) : n(n), balance(n + 1, 0) {
+    this->judge = n == 1 ? 1 : -1;
+  }
+
+  /// @brief Records that person `a` trusts person `b`.
+  ///
+  /// Each pair must be recorded at most once, as in the original problem.
+  ///
+  /// @param a The person who trusts.
+  /// @param b The person who is trusted.
+  void addTrust(int a, int b) {
+    this->balance[a]--;
+    this->balance[b]++;
+
+    this->refresh(a);
+    this->refresh(b);
+  }
+
+  /// @brief Records a batch of trust relationships.
+  /// @tparam Edges Any range whose elements expose the truster as `edge[0]`
+  /// and the trusted person as `edge[1]`.
+  /// @param trust A constant reference to the trust relationships.
+  template <typename Edges>
+  void addTrusts(const Edges& trust) {
+    for (const auto& current : trust) {
+      this->addTrust(current[0], current[1]);
     }
+  }
 
-    return -1;
+  /// @brief Returns the label of the current Town Judge, or -1 if there is
+  /// none.
+  int currentJudge() const { return this->judge; }
+
+ private:
+  /// @brief Updates the Judge after the balance of `person` changed.
+  void refresh(int person) {
+    if (this->balance[person] == this->n - 1) {
+      this->judge = person;
+    } else if (this->judge == person) {
+      this->judge = -1;
+    }
   }
+
+  /// @brief The total number of people in the town.
+  int n;
+  /// @brief The trust balance of every person, indexed by label.
+  vector<int> balance;
+  /// @brief The label of the current Judge, or -1.
+  int judge;
 };
\ No newline at end of file
@@ -0,0 +1,438 @@
+/// @brief Helpers shared by the thread-ordering solutions: where callbacks run,
+/// the opt-in contention probe, and the coroutine task, baton and pool.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using std::array;
+using std::chrono::nanoseconds;
+using std::chrono::steady_clock;
+using std::condition_variable;
+using std::coroutine_handle;
+using std::deque;
+using std::function;
+using std::lock_guard;
+using std::mutex;
+using std::size_t;
+using std::string;
+using std::thread;
+using std::uint64_t;
+using std::unique_lock;
+using std::vector;
+
+/// @brief Where a callback passed to an ordering class runs relative to the
+/// mutex of that class.
+enum class CallbackPlacement {
+  /// @brief The callback runs while the mutex is held, as in the original
+  /// solutions.
+  UnderLock,
+  /// @brief The mutex is released around the callback. The order is still
+  /// kept, because the turn state only changes after the callback returns.
+  OutsideLock,
+};
+
+#ifdef ORDERING_INSTRUMENTATION
+/// @brief Whether the ordering classes record contention metrics. Defining
+/// `ORDERING_INSTRUMENTATION` turns it on; otherwise every probe is empty and
+/// compiles to nothing.
+inline constexpr bool orderingInstrumentation = true;
+#else
+inline constexpr bool orderingInstrumentation = false;
+#endif
+
+/// @class LatencyHistogram
+/// @brief A histogram of durations with power-of-two nanosecond buckets.
+///
+/// Bucket `i` counts the durations whose nanosecond value has `i` significant
+/// bits, so recording a sample is a `bit_width` and an increment.
+class LatencyHistogram {
+ public:
+  /// @brief The number of buckets; the last one also holds every longer
+  /// duration.
+  static constexpr size_t bucketCount = 48;
+
+  /// @brief Adds one duration to the histogram.
+  void record(nanoseconds duration) {
+    const uint64_t ticks = std::max<std::int64_t>(duration.count(), 0);
+    const size_t bucket =
+        std::min<size_t>(std::bit_width(ticks), bucketCount - 1);
+
+    this->buckets[bucket]++;
+    this->samples++;
+    this->totalTicks += ticks;
+  }
+
+  /// @brief Returns the number of recorded durations.
+  uint64_t count() const { return this->samples; }
+
+  /// @brief Returns the sum of every recorded duration, in nanoseconds.
+  uint64_t totalNanoseconds() const { return this->totalTicks; }
+
+  /// @brief Returns an upper bound of the given percentile, in nanoseconds.
+  /// @param fraction The percentile as a fraction, e.g. `0.99`.
+  uint64_t percentileNanoseconds(double fraction) const {
+    const double rank = fraction * this->samples;
+    uint64_t seen = 0;
+
+    for (size_t bucket = 0; bucket < bucketCount; bucket++) {
+      seen += this->buckets[bucket];
+
+      if (seen > 0 && seen >= rank) {
+        return (uint64_t{1} << bucket) - 1;
+      }
+    }
+
+    return 0;
+  }
+
+  /// @brief Returns the histogram as a JSON object.
+  string toJson() const {
+    string json = "{\"count\":" + std::to_string(this->samples) +
+                  ",\"totalNs\":" + std::to_string(this->totalTicks);
+
+    json += ",\"p50Ns\":" + std::to_string(this->percentileNanoseconds(0.5));
+    json += ",\"p99Ns\":" + std::to_string(this->percentileNanoseconds(0.99));
+    json += ",\"buckets\":[";
+
+    for (size_t bucket = 0; bucket < bucketCount; bucket++) {
+      json += (bucket == 0 ? "" : ",") + std::to_string(this->buckets[bucket]);
+    }
+
+    return json + "]}";
+  }
+
+ private:
+  /// @brief The number of durations in each bucket.
+  array<uint64_t, bucketCount> buckets{};
+  /// @brief The number of recorded durations.
+  uint64_t samples = 0;
+  /// @brief The sum of every recorded duration, in nanoseconds.
+  uint64_t totalTicks = 0;
+};
+
+/// @brief The contention metrics of one role.
+struct RoleMetrics {
+  /// @brief The name of the role.
+  string role;
+  /// @brief How long the role waited for each of its turns.
+  LatencyHistogram waitTime;
+  /// @brief How long each turn took to start after the previous role handed
+  /// it over.
+  LatencyHistogram handOffLatency;
+  /// @brief How long each callback ran.
+  LatencyHistogram callbackTime;
+  /// @brief How many times the role woke up from the condition variable.
+  uint64_t wakeUps = 0;
+  /// @brief How many of those wake-ups found that it was the role's turn.
+  uint64_t usefulWakeUps = 0;
+
+  /// @brief Returns the metrics as a JSON object.
+  string toJson() const {
+    return "{\"role\":\"" + this->role + "\",\"wakeUps\":" +
+           std::to_string(this->wakeUps) + ",\"usefulWakeUps\":" +
+           std::to_string(this->usefulWakeUps) + ",\"waitTime\":" +
+           this->waitTime.toJson() + ",\"handOffLatency\":" +
+           this->handOffLatency.toJson() + ",\"callbackTime\":" +
+           this->callbackTime.toJson() + "}";
+  }
+};
+
+/// @class OrderingProbe
+/// @brief Records the contention metrics of every role of an ordering object.
+///
+/// The metrics of a role are only ever written by the thread running that
+/// role, so they are plain counters with no atomics. Read them once the role
+/// threads have been joined.
+///
+/// @tparam Enabled Whether anything is recorded; see the `false`
+/// specialization.
+/// @tparam Roles The number of roles.
+template <bool Enabled, size_t Roles>
+class OrderingProbe {
+ public:
+  /// @brief Creates a probe with empty metrics for the named roles.
+  explicit OrderingProbe(array<const char*, Roles> names) {
+    for (size_t role = 0; role < Roles; role++) {
+      this->roles[role].role = names[role];
+    }
+  }
+
+  /// @brief Marks the moment a role starts waiting or calling back.
+  steady_clock::time_point now() const { return steady_clock::now(); }
+
+  /// @brief Records one wake-up of `role`.
+  void wokeUp(size_t role, bool useful) {
+    this->roles[role].wakeUps++;
+    this->roles[role].usefulWakeUps += useful;
+  }
+
+  /// @brief Records that `role` got its turn after waiting since `start`.
+  void gotTurn(size_t role, steady_clock::time_point start) {
+    const steady_clock::time_point end = steady_clock::now();
+
+    this->roles[role].waitTime.record(end - start);
+
+    if (this->handOffAt != steady_clock::time_point()) {
+      this->roles[role].handOffLatency.record(end - this->handOffAt);
+    }
+  }
+
+  /// @brief Records a callback of `role` that started at `start`.
+  void calledBack(size_t role, steady_clock::time_point start) {
+    this->roles[role].callbackTime.record(steady_clock::now() - start);
+  }
+
+  /// @brief Records that the current role just handed the turn over.
+  void handedOff() { this->handOffAt = steady_clock::now(); }
+
+  /// @brief Returns a copy of the metrics of every role.
+  array<RoleMetrics, Roles> snapshot() const { return this->roles; }
+
+ private:
+  /// @brief The metrics of every role.
+  array<RoleMetrics, Roles> roles;
+  /// @brief When the turn was last handed over.
+  steady_clock::time_point handOffAt;
+};
+
+/// @brief The disabled probe: every call is an empty inline function and the
+/// object takes no space.
+template <size_t Roles>
+class OrderingProbe<false, Roles> {
+ public:
+  explicit OrderingProbe(array<const char*, Roles>) {}
+  steady_clock::time_point now() const { return steady_clock::time_point(); }
+  void wokeUp(size_t, bool) {}
+  void gotTurn(size_t, steady_clock::time_point) {}
+  void calledBack(size_t, steady_clock::time_point) {}
+  void handedOff() {}
+};
+
+/// @brief Returns the metrics of several roles as one JSON object.
+template <size_t Roles>
+string metricsToJson(const array<RoleMetrics, Roles>& metrics) {
+  string json = "{\"roles\":[";
+
+  for (size_t role = 0; role < Roles; role++) {
+    json += (role == 0 ? "" : ",") + metrics[role].toJson();
+  }
+
+  return json + "]}";
+}
+
+/// @class RoleTask
+/// @brief The coroutine type of a role that runs under a `CoroutinePool`.
+///
+/// The coroutine starts suspended, so that every role of an instance can be
+/// created before any of them runs, and it stays suspended at its end until
+/// the task is destroyed, which also frees the coroutine frame.
+class RoleTask {
+ public:
+  struct promise_type {
+    RoleTask get_return_object() {
+      return RoleTask(coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  RoleTask(RoleTask&& other) noexcept
+      : handle(std::exchange(other.handle, nullptr)) {}
+  RoleTask(const RoleTask&) = delete;
+  RoleTask& operator=(const RoleTask&) = delete;
+
+  ~RoleTask() {
+    if (this->handle) {
+      this->handle.destroy();
+    }
+  }
+
+  /// @brief Runs the role until it first has to wait for its turn.
+  void start() { this->handle.resume(); }
+
+ private:
+  explicit RoleTask(coroutine_handle<promise_type> handle) : handle(handle) {}
+
+  /// @brief The coroutine owned by the task.
+  coroutine_handle<promise_type> handle;
+};
+
+/// @class TurnBaton
+/// @brief Decides which role of a coroutine instance may run.
+///
+/// A role that finds the turn taken parks its coroutine in its own slot and
+/// returns control to whoever resumed it. A role that ends its turn parks
+/// itself the same way and resumes the successor directly through symmetric
+/// transfer, so a hand-off is a jump between coroutine frames on the same
+/// thread. All roles of an instance must be started on the same thread.
+///
+/// @tparam Roles The number of roles.
+template <size_t Roles>
+class TurnBaton {
+ public:
+  /// @brief The awaiter returned by `turnOf`.
+  struct TurnAwaiter {
+    TurnBaton& baton;
+    size_t role;
+
+    bool await_ready() const noexcept { return this->baton.turn == this->role; }
+
+    void await_suspend(coroutine_handle<> waiter) noexcept {
+      this->baton.parked[this->role] = waiter;
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  /// @brief The awaiter returned by `handOff`.
+  struct HandOffAwaiter {
+    TurnBaton& baton;
+    size_t from;
+    size_t to;
+
+    bool await_ready() const noexcept { return false; }
+
+    coroutine_handle<> await_suspend(coroutine_handle<> waiter) noexcept {
+      this->baton.turn = this->to;
+      this->baton.parked[this->from] = waiter;
+
+      coroutine_handle<> successor =
+          std::exchange(this->baton.parked[this->to], nullptr);
+
+      return successor ? successor : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  /// @brief Suspends the caller until it is the turn of `role`.
+  TurnAwaiter turnOf(size_t role) { return TurnAwaiter{*this, role}; }
+
+  /// @brief Gives the turn from `from` to `to` and resumes `to` if it is
+  /// parked. The caller is resumed when the turn comes back to `from`.
+  HandOffAwaiter handOff(size_t from, size_t to) {
+    return HandOffAwaiter{*this, from, to};
+  }
+
+ private:
+  /// @brief The role whose turn it is.
+  size_t turn = 0;
+  /// @brief The parked coroutine of each role, if any.
+  array<coroutine_handle<>, Roles> parked{};
+};
+
+/// @class CoroutinePool
+/// @brief A small pool of threads that runs coroutine instances.
+///
+/// Each posted job starts every role of one instance on a pool thread. From
+/// then on the roles hand turns to each other by symmetric transfer, so the
+/// whole instance runs to completion inside that job, and thousands of
+/// instances share a handful of threads.
+class CoroutinePool {
+ public:
+  /// @brief Starts the pool.
+  /// @param threads The number of threads. Zero picks one per hardware
+  /// thread.
+  explicit CoroutinePool(unsigned threads = 0) {
+    const unsigned count =
+        threads != 0 ? threads : std::max(1u, thread::hardware_concurrency());
+
+    for (unsigned i = 0; i < count; i++) {
+      this->workers.emplace_back([this]() { this->work(); });
+    }
+  }
+
+  /// @brief Runs every job still queued and stops the threads.
+  ~CoroutinePool() {
+    {
+      lock_guard<mutex> lock(this->jobsMutex);
+      this->stopping = true;
+    }
+
+    this->jobsCV.notify_all();
+
+    for (thread& worker : this->workers) {
+      worker.join();
+    }
+  }
+
+  /// @brief Queues a job.
+  void post(function<void()> job) {
+    {
+      lock_guard<mutex> lock(this->jobsMutex);
+      this->jobs.push_back(std::move(job));
+      this->unfinished++;
+    }
+
+    this->jobsCV.notify_one();
+  }
+
+  /// @brief Blocks until every job posted so far has finished.
+  void wait() {
+    unique_lock<mutex> lock(this->jobsMutex);
+    this->idleCV.wait(lock, [this]() { return this->unfinished == 0; });
+  }
+
+ private:
+  /// @brief The loop run by every pool thread.
+  void work() {
+    while (true) {
+      function<void()> job;
+
+      {
+        unique_lock<mutex> lock(this->jobsMutex);
+        this->jobsCV.wait(
+            lock, [this]() { return this->stopping || !this->jobs.empty(); });
+
+        if (this->jobs.empty()) {
+          return;
+        }
+
+        job = std::move(this->jobs.front());
+        this->jobs.pop_front();
+      }
+
+      job();
+
+      lock_guard<mutex> lock(this->jobsMutex);
+
+      if (--this->unfinished == 0) {
+        this->idleCV.notify_all();
+      }
+    }
+  }
+
+  /// @brief The pool threads.
+  vector<thread> workers;
+  /// @brief The jobs waiting for a thread.
+  deque<function<void()>> jobs;
+  /// @brief The number of jobs posted but not finished.
+  size_t unfinished = 0;
+  /// @brief Whether the pool is shutting down.
+  bool stopping = false;
+  /// @brief The mutex used to protect the queue and the counters.
+  mutex jobsMutex;
+  /// @brief The condition variable the pool threads sleep on.
+  condition_variable jobsCV;
+  /// @brief The condition variable `wait` sleeps on.
+  condition_variable idleCV;
+};
@@ -1,5 +1,22 @@
+#include <algorithm>
+#include <array>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <string>
+#include <thread>
 #include <vector>
 
+using std::array;
+using std::barrier;
+using std::size_t;
+using std::span;
+using std::string;
+using std::thread;
+using std::uint32_t;
+using std::uint64_t;
 using std::vector;
 
 /// @brief A class to solve the Pascal's Triangle problem.
@@ -31,9 +48,9 @@ class Solution {
  private:
   /// @brief Generates the next row of the triangle from the previous one.
   ///
-  /// This private helper method calculates each element of the new row by
-  /// summing adjacent elements from the previous row. It handles the edge
-  /// cases by treating non-existent elements as zero.
+  /// This private helper method sets both ends of the new row to `1` and
+  /// calculates every inner element by summing the two elements above it, so
+  /// the inner loop needs no boundary checks.
   ///
   /// @param row A constant reference to the previous row of the triangle.
   /// @return A new vector of integers representing the next row.
@@ -41,14 +58,416 @@ class Solution {
     const std::size_t nextRowLen = row.size() + 1;
 
     vector<int> next(nextRowLen);
+    next.front() = 1;
+    next.back() = 1;
 
-    for (std::size_t i = 0; i < nextRowLen; i++) {
-      const int left = i == 0 ? 0 : row[i - 1];
-      const int right = i >= nextRowLen - 1 ? 0 : row[i];
-
-      next[i] = left + right;
+    for (std::size_t i = 1; i < nextRowLen - 1; i++) {
+      next[i] = row[i - 1] + row[i];
     }
 
     return next;
   }
+};
+
+/// @brief An integer modulo `Modulus`, closed under addition.
+///
+/// It lets the triangle be built for any number of rows without overflow when
+/// only the coefficients modulo a number are needed.
+///
+/// @tparam Modulus The modulus, at most `2^31`.
+template <uint32_t Modulus>
+struct ModularInt {
+  /// @brief The value, always in `[0, Modulus)`.
+  uint32_t value = 0;
+
+  ModularInt() = default;
+
+  /// @brief Creates the residue of `value` modulo `Modulus`.
+  ModularInt(uint64_t value) : value(value % Modulus) {}
+
+  friend ModularInt operator+(ModularInt left, ModularInt right) {
+    const uint32_t sum = left.value + right.value;
+    ModularInt result;
+    result.value = sum >= Modulus ? sum - Modulus : sum;
+
+    return result;
+  }
+
+  friend bool operator==(ModularInt left, ModularInt right) = default;
+};
+
+/// @brief An arbitrary-precision natural number, closed under addition.
+///
+/// It stores base `10^9` digits, least significant first, which is all the
+/// triangle needs to hold exact coefficients past the range of `uint64_t`.
+class BigNatural {
+ public:
+  BigNatural() = default;
+
+  /// @brief Creates a number equal to `value`.
+  BigNatural(uint64_t value) {
+    while (value != 0) {
+      this->digits.push_back(value % base);
+      value /= base;
+    }
+  }
+
+  friend BigNatural operator+(const BigNatural& left, const BigNatural& right) {
+    const vector<uint32_t>& longer =
+        left.digits.size() >= right.digits.size() ? left.digits : right.digits;
+    const vector<uint32_t>& shorter =
+        &longer == &left.digits ? right.digits : left.digits;
+
+    BigNatural sum;
+    sum.digits.reserve(longer.size() + 1);
+    uint32_t carry = 0;
+
+    for (size_t i = 0; i < longer.size(); i++) {
+      const uint32_t digit =
+          longer[i] + (i < shorter.size() ? shorter[i] : 0) + carry;
+
+      carry = digit >= base;
+      sum.digits.push_back(carry ? digit - base : digit);
+    }
+
+    if (carry) {
+      sum.digits.push_back(carry);
+    }
+
+    return sum;
+  }
+
+  friend bool operator==(const BigNatural& left,
+                         const BigNatural& right) = default;
+
+  /// @brief Returns the decimal representation of the number.
+  string toString() const {
+    if (this->digits.empty()) {
+      return "0";
+    }
+
+    string text = std::to_string(this->digits.back());
+
+    for (size_t i = this->digits.size() - 1; i-- > 0;) {
+      const string digit = std::to_string(this->digits[i]);
+      text.append(9 - digit.size(), '0').append(digit);
+    }
+
+    return text;
+  }
+
+ private:
+  /// @brief The base of each stored digit.
+  static constexpr uint32_t base = 1000000000;
+
+  /// @brief The base `10^9` digits, least significant first.
+  vector<uint32_t> digits;
+};
+
+/// @class PascalTriangle
+/// @brief A Pascal's Triangle stored row after row in one flat buffer.
+///
+/// Row `i` starts at offset `i * (i + 1) / 2` and holds `i + 1` elements, so
+/// the whole triangle takes a single allocation instead of one vector per row.
+/// Each row is written in place from the one before it: the ends are set to
+/// `1` and the inner elements are sums of neighbors above, in a loop with no
+/// branches that the compiler vectorizes for built-in element types.
+///
+/// @tparam T The element type, e.g. `int64_t`, `ModularInt` or `BigNatural`.
+/// It must be constructible from `1` and closed under `+`.
+template <typename T>
+class PascalTriangle {
+ public:
+  /// @brief Builds the first `numRows` rows of the triangle.
+  /// @param numRows The number of rows to generate.
+  explicit PascalTriangle(int numRows)
+      : numRows(numRows), cells(offsetOf(numRows)) {
+    for (int i = 0; i < numRows; i++) {
+      T* next = this->cells.data() + offsetOf(i);
+      const T* previous = next - i;
+
+      next[0] = T(1);
+      next[i] = T(1);
+
+      for (int j = 1; j < i; j++) {
+        next[j] = previous[j - 1] + previous[j];
+      }
+    }
+  }
+
+  /// @brief Returns the number of rows in the triangle.
+  int size() const { return this->numRows; }
+
+  /// @brief Returns one row of the triangle.
+  /// @param i The index of the row, starting at 0.
+  /// @return A read-only view of the `i + 1` elements of the row.
+  span<const T> row(int i) const {
+    return span<const T>(this->cells.data() + offsetOf(i), i + 1);
+  }
+
+ private:
+  /// @brief Returns the position of the first element of row `i`.
+  static size_t offsetOf(int i) { return static_cast<size_t>(i) * (i + 1) / 2; }
+
+  /// @brief The number of rows in the triangle.
+  int numRows;
+  /// @brief Every row of the triangle, back to back.
+  vector<T> cells;
+};
+
+/// @class PascalRow
+/// @brief A single row of Pascal's Triangle that advances in place.
+///
+/// Only the current row is kept, in a buffer reserved once for the last row
+/// that will be reached. Each step appends a `1` and then adds every element
+/// to its right neighbor from right to left, so no element is overwritten
+/// before it has been read.
+///
+/// @tparam T The element type; see `PascalTriangle`.
+template <typename T>
+class PascalRow {
+ public:
+  /// @brief Creates the first row of the triangle.
+  /// @param maxIndex The index of the last row that will be reached, used to
+  /// reserve the buffer once.
+  explicit PascalRow(int maxIndex = 0) {
+    this->cells.reserve(maxIndex + 1);
+    this->cells.push_back(T(1));
+  }
+
+  /// @brief Turns the current row into the next one.
+  void advance() {
+    this->cells.push_back(T(1));
+
+    for (size_t j = this->cells.size() - 2; j > 0; j--) {
+      this->cells[j] = this->cells[j] + this->cells[j - 1];
+    }
+  }
+
+  /// @brief Returns the index of the current row.
+  int index() const { return static_cast<int>(this->cells.size()) - 1; }
+
+  /// @brief Returns the elements of the current row.
+  span<const T> values() const { return this->cells; }
+
+ private:
+  /// @brief The elements of the current row.
+  vector<T> cells;
+};
+
+/// @brief The number of rows whose coefficients all fit in a `uint64_t`.
+inline constexpr int exactRows = 68;
+
+/// @brief Builds the first `exactRows` rows of the triangle at compile time.
+/// @return The rows stored back to back, as in `PascalTriangle`.
+constexpr array<uint64_t, exactRows * (exactRows + 1) / 2> buildExactTriangle() {
+  array<uint64_t, exactRows * (exactRows + 1) / 2> cells{};
+  size_t offset = 0;
+
+  for (int i = 0; i < exactRows; i++) {
+    cells[offset] = 1;
+    cells[offset + i] = 1;
+
+    for (int j = 1; j < i; j++) {
+      cells[offset + j] = cells[offset - i + j - 1] + cells[offset - i + j];
+    }
+
+    offset += i + 1;
+  }
+
+  return cells;
+}
+
+/// @brief The first `exactRows` rows of the triangle, computed by the compiler.
+inline constexpr auto exactTriangle = buildExactTriangle();
+
+/// @brief Returns `C(n, k)` by reading it from `exactTriangle`.
+/// @param n The row, in `[0, exactRows)`.
+/// @param k The position in the row, in `[0, n]`.
+/// @return The binomial coefficient `C(n, k)`.
+constexpr uint64_t exactBinomial(int n, int k) {
+  return exactTriangle[static_cast<size_t>(n) * (n + 1) / 2 + k];
+}
+
+/// @brief Computes row `n` of the triangle directly, without the rows above.
+///
+/// It uses the multiplicative recurrence `C(n, k + 1) = C(n, k) * (n - k) /
+/// (k + 1)`. The common factor of `C(n, k)` and `k + 1` is divided out first,
+/// which keeps the product exact and no larger than the next coefficient
+/// times `n`.
+///
+/// @param n The row, in `[0, exactRows)`.
+/// @return The `n + 1` coefficients of row `n`.
+inline vector<uint64_t> binomialRow(int n) {
+  vector<uint64_t> row(n + 1);
+  row[0] = 1;
+
+  for (int k = 0; k < n; k++) {
+    const uint64_t divisor = k + 1;
+    const uint64_t common = std::gcd(row[k], divisor);
+
+    row[k + 1] = row[k] / common * ((n - k) / (divisor / common));
+  }
+
+  return row;
+}
+
+/// @class BinomialModTable
+/// @brief Answers `C(n, k) mod p` queries in constant time.
+///
+/// The table precomputes `i!` and `(i!)^-1` modulo a prime `p` for every `i`
+/// up to a bound, so each query is three table reads and two multiplications.
+class BinomialModTable {
+ public:
+  /// @brief Precomputes the factorial tables.
+  /// @param maxN The largest `n` that will be queried; it must be below `p`.
+  /// @param modulus The prime `p`, below `2^32`.
+  BinomialModTable(int maxN, uint32_t modulus)
+      : modulus(modulus), factorials(maxN + 1), inverseFactorials(maxN + 1) {
+    this->factorials[0] = 1;
+
+    for (int i = 1; i <= maxN; i++) {
+      this->factorials[i] = this->factorials[i - 1] * i % modulus;
+    }
+
+    this->inverseFactorials[maxN] =
+        this->power(this->factorials[maxN], modulus - 2);
+
+    for (int i = maxN; i > 0; i--) {
+      this->inverseFactorials[i - 1] = this->inverseFactorials[i] * i % modulus;
+    }
+  }
+
+  /// @brief Returns `C(n, k) mod p`.
+  /// @param n The row, in `[0, maxN]`.
+  /// @param k The position in the row; values outside `[0, n]` give 0.
+  /// @return The binomial coefficient modulo `p`.
+  uint64_t choose(int n, int k) const {
+    if (k < 0 || k > n) {
+      return 0;
+    }
+
+    return this->factorials[n] * this->inverseFactorials[k] % this->modulus *
+           this->inverseFactorials[n - k] % this->modulus;
+  }
+
+  /// @brief Returns row `n` of the triangle modulo `p`.
+  /// @param n The row, in `[0, maxN]`.
+  /// @return The `n + 1` coefficients of row `n` modulo `p`.
+  vector<uint64_t> row(int n) const {
+    vector<uint64_t> coefficients(n + 1);
+
+    for (int k = 0; k <= n; k++) {
+      coefficients[k] = this->choose(n, k);
+    }
+
+    return coefficients;
+  }
+
+ private:
+  /// @brief Raises `base` to `exponent` modulo `p` by repeated squaring.
+  uint64_t power(uint64_t base, uint64_t exponent) const {
+    uint64_t result = 1;
+
+    while (exponent != 0) {
+      if (exponent & 1) {
+        result = result * base % this->modulus;
+      }
+
+      base = base * base % this->modulus;
+      exponent >>= 1;
+    }
+
+    return result;
+  }
+
+  /// @brief The prime modulus.
+  uint64_t modulus;
+  /// @brief `i! mod p` for every `i` up to the bound.
+  vector<uint64_t> factorials;
+  /// @brief The modular inverse of `i!` for every `i` up to the bound.
+  vector<uint64_t> inverseFactorials;
+};
+
+/// @class ParallelPascalGenerator
+/// @brief Generates very tall Pascal's Triangles on several threads and
+/// streams each row out as soon as it is complete.
+///
+/// Only two rows are held at any time. For each new row, every worker fills
+/// its own slice of the inner elements from the previous row; a barrier then
+/// closes the row, hands it to the sink and swaps the buffers. The additions
+/// are the same as in the serial version, so the rows are identical to it.
+class ParallelPascalGenerator {
+ public:
+  /// @brief Creates a generator that runs on the given number of threads.
+  /// @param threads The number of workers, including the calling thread. Zero
+  /// picks one worker per hardware thread.
+  explicit ParallelPascalGenerator(unsigned threads = 0)
+      : threads(threads != 0 ? threads
+                             : std::max(1u, thread::hardware_concurrency())) {}
+
+  /// @brief Generates the first `numRows` rows and passes each one to `sink`.
+  ///
+  /// The sink is called once per row, in order, and never concurrently. It
+  /// runs while the workers wait on the barrier, so it must not throw, and the
+  /// view it receives is only valid until it returns.
+  ///
+  /// @tparam T The element type; see `PascalTriangle`.
+  /// @tparam Sink A callable taking a `span<const T>`.
+  /// @param numRows The number of rows to generate.
+  /// @param sink The consumer of the rows.
+  template <typename T, typename Sink>
+  void generate(int numRows, Sink&& sink) const {
+    if (numRows <= 0) {
+      return;
+    }
+
+    vector<T> previous(numRows);
+    vector<T> current(numRows);
+    int rowIndex = 1;
+
+    previous[0] = T(1);
+    sink(span<const T>(previous.data(), 1));
+
+    auto finishRow = [&]() noexcept {
+      current[0] = T(1);
+      current[rowIndex] = T(1);
+      sink(span<const T>(current.data(), rowIndex + 1));
+
+      previous.swap(current);
+      rowIndex++;
+    };
+
+    barrier rowEnd(this->threads, finishRow);
+
+    auto work = [&](unsigned worker) {
+      while (rowIndex < numRows) {
+        const size_t inner = rowIndex - 1;
+        const size_t begin = 1 + inner * worker / this->threads;
+        const size_t end = 1 + inner * (worker + 1) / this->threads;
+
+        for (size_t j = begin; j < end; j++) {
+          current[j] = previous[j - 1] + previous[j];
+        }
+
+        rowEnd.arrive_and_wait();
+      }
+    };
+
+    vector<thread> workers;
+
+    for (unsigned worker = 1; worker < this->threads; worker++) {
+      workers.emplace_back(work, worker);
+    }
+
+    work(0);
+
+    for (thread& worker : workers) {
+      worker.join();
+    }
+  }
+
+ private:
+  /// @brief The number of workers.
+  unsigned threads;
 };
\ No newline at end of file
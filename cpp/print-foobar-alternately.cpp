@@ -1,10 +1,26 @@
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <mutex>
+#include <string>
+#include <thread>
 
+#include "ordering-support.hpp"
+
+using std::array;
+using std::atomic;
+using std::chrono::steady_clock;
 using std::condition_variable;
 using std::function;
 using std::mutex;
+using std::size_t;
+using std::string;
+using std::thread;
+using std::uint32_t;
 using std::unique_lock;
 
 /// @class FooBar
@@ -24,6 +40,14 @@ class FooBar {
   mutex isFooTimeMtx;
   /// @brief The condition variable used to block and unblock threads based on whose turn it is.
   condition_variable isFooTimeCV;
+  /// @brief The contention metrics of both roles; empty unless
+  /// `ORDERING_INSTRUMENTATION` is defined.
+  [[no_unique_address]] OrderingProbe<orderingInstrumentation, 2> probe{
+      {"foo", "bar"}};
+
+  /// @brief The index of each role in `probe`.
+  static constexpr size_t fooRole = 0;
+  static constexpr size_t barRole = 1;
 
  public:
   /// @brief Constructs a new FooBar object.
@@ -39,13 +63,27 @@ class FooBar {
   /// executes its action, then signals to `bar` that its turn has ended.
   /// @param printFoo A callable object to be executed when it's `foo`'s turn.
   void foo(function<void()> printFoo) {
+    this->foo<CallbackPlacement::UnderLock>(printFoo);
+  }
+
+  /// @brief Executes the `foo` part of the sequence with any callable.
+  ///
+  /// The callable is taken as is rather than wrapped in a `std::function`, so
+  /// passing it never allocates and the compiler can inline it into the loop.
+  /// @tparam Placement Whether `printFoo` runs with the mutex held.
+  /// @tparam PrintFoo Any callable taking no arguments.
+  /// @param printFoo A callable object to be executed when it's `foo`'s turn.
+  template <CallbackPlacement Placement = CallbackPlacement::UnderLock,
+            typename PrintFoo>
+  void foo(PrintFoo&& printFoo) {
     for (int i = 0; i < this->n; i++) {
       unique_lock<mutex> lock(this->isFooTimeMtx);
-      this->isFooTimeCV.wait(lock, [this]() { return this->isFooTime; });
+      this->awaitTurn(lock, fooRole, [this]() { return this->isFooTime; });
 
-      printFoo();
+      this->invoke<Placement>(lock, fooRole, printFoo);
 
       this->isFooTime = false;
+      this->probe.handedOff();
       this->isFooTimeCV.notify_one();
     }
   }
@@ -56,14 +94,259 @@ class FooBar {
   /// executes its action, then signals to `foo` that its turn has ended.
   /// @param printBar A callable object to be executed when it's `bar`'s turn.
   void bar(function<void()> printBar) {
+    this->bar<CallbackPlacement::UnderLock>(printBar);
+  }
+
+  /// @brief Executes the `bar` part of the sequence with any callable.
+  ///
+  /// The callable is taken as is rather than wrapped in a `std::function`, so
+  /// passing it never allocates and the compiler can inline it into the loop.
+  /// @tparam Placement Whether `printBar` runs with the mutex held.
+  /// @tparam PrintBar Any callable taking no arguments.
+  /// @param printBar A callable object to be executed when it's `bar`'s turn.
+  template <CallbackPlacement Placement = CallbackPlacement::UnderLock,
+            typename PrintBar>
+  void bar(PrintBar&& printBar) {
     for (int i = 0; i < this->n; i++) {
       unique_lock<mutex> lock(this->isFooTimeMtx);
-      this->isFooTimeCV.wait(lock, [this]() { return !this->isFooTime; });
+      this->awaitTurn(lock, barRole, [this]() { return !this->isFooTime; });
 
-      printBar();
+      this->invoke<Placement>(lock, barRole, printBar);
 
       this->isFooTime = true;
+      this->probe.handedOff();
       this->isFooTimeCV.notify_one();
     }
   }
+
+#ifdef ORDERING_INSTRUMENTATION
+  /// @brief Returns the contention metrics of `foo` and `bar`. Only call it
+  /// once both threads are done.
+  array<RoleMetrics, 2> metrics() const { return this->probe.snapshot(); }
+
+  /// @brief Returns the contention metrics of `foo` and `bar` as JSON.
+  string metricsJson() const { return metricsToJson(this->metrics()); }
+#endif
+
+ private:
+  /// @brief Waits on the condition variable until `isTurn` holds, counting
+  /// every wake-up of `role` in the probe.
+  template <typename Predicate>
+  void awaitTurn(unique_lock<mutex>& lock, size_t role, Predicate isTurn) {
+    const steady_clock::time_point start = this->probe.now();
+
+    while (!isTurn()) {
+      this->isFooTimeCV.wait(lock);
+      this->probe.wokeUp(role, isTurn());
+    }
+
+    this->probe.gotTurn(role, start);
+  }
+
+  /// @brief Calls `callback`, releasing `lock` around it if `Placement` asks
+  /// for it.
+  template <CallbackPlacement Placement, typename Callback>
+  void invoke(unique_lock<mutex>& lock, size_t role, Callback& callback) {
+    const steady_clock::time_point start = this->probe.now();
+
+    if constexpr (Placement == CallbackPlacement::OutsideLock) {
+      lock.unlock();
+      callback();
+      lock.lock();
+    } else {
+      callback();
+    }
+
+    this->probe.calledBack(role, start);
+  }
+};
+
+/// @brief Tells the processor that the caller is in a spin-wait loop, which
+/// saves power and frees execution resources for a sibling hyper-thread.
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+/// @brief How a thread waits for its turn in a `TurnSequencer`.
+enum class WaitPolicy {
+  /// @brief Busy-wait and never sleep on the atomic. Past the spin limit each
+  /// check is preceded by `std::this_thread::yield()`, a `sched_yield` system
+  /// call, so that a waiting thread cannot starve the one whose turn it is
+  /// when there are fewer cores than threads; `pass` never notifies.
+  Spin,
+  /// @brief Busy-wait for a bounded number of checks, then sleep on the atomic.
+  SpinThenPark,
+  /// @brief Sleep on the atomic right away.
+  Park,
+};
+
+/// @class TurnSequencer
+/// @brief Hands turns between threads through a single atomic, with no mutex.
+///
+/// The current turn lives alone on its own cache line, so that the threads
+/// polling it do not share that line with any other data. A thread waits
+/// according to the chosen `WaitPolicy`, and parked threads are woken with
+/// `atomic::notify_one`.
+class TurnSequencer {
+ public:
+  /// @brief Creates a sequencer whose first turn is 0.
+  /// @param policy How threads wait for their turn.
+  explicit TurnSequencer(WaitPolicy policy = WaitPolicy::SpinThenPark)
+      : policy(policy) {}
+
+  /// @brief Blocks until the current turn is `expected`.
+  /// @param expected The turn to wait for.
+  void waitFor(uint32_t expected) {
+    uint32_t current = this->turn.load(std::memory_order_acquire);
+
+    for (int spins = 0; current != expected; spins++) {
+      if (this->policy == WaitPolicy::Park ||
+          (this->policy == WaitPolicy::SpinThenPark && spins >= spinLimit)) {
+        this->turn.wait(current, std::memory_order_acquire);
+      } else if (spins >= spinLimit) {
+        std::this_thread::yield();
+      } else {
+        cpuRelax();
+      }
+
+      current = this->turn.load(std::memory_order_acquire);
+    }
+  }
+
+  /// @brief Ends the current turn and gives the next one to `next`.
+  /// @param next The turn to start.
+  void pass(uint32_t next) {
+    this->turn.store(next, std::memory_order_release);
+
+    if (this->policy != WaitPolicy::Spin) {
+      this->turn.notify_one();
+    }
+  }
+
+ private:
+  /// @brief The assumed size of a cache line.
+  static constexpr std::size_t cacheLineSize = 64;
+  /// @brief How many times a spinning thread checks the turn before it parks
+  /// or yields.
+  static constexpr int spinLimit = 4096;
+
+  /// @brief The current turn, alone on its cache line.
+  alignas(cacheLineSize) atomic<uint32_t> turn = 0;
+  /// @brief How threads wait for their turn.
+  alignas(cacheLineSize) WaitPolicy policy;
+};
+
+/// @class AtomicFooBar
+/// @brief A `FooBar` that hands each turn over through a `TurnSequencer`
+/// instead of a mutex and a condition variable.
+///
+/// With the `Spin` and `SpinThenPark` policies, a hand-off between two running
+/// threads is just an atomic store seen by the other thread's polling loop,
+/// with no futex round-trip and no context switch.
+class AtomicFooBar {
+ public:
+  /// @brief Constructs a new AtomicFooBar object.
+  /// @param n The number of alternating `foo` and `bar` calls.
+  /// @param policy How each thread waits for its turn.
+  AtomicFooBar(int n, WaitPolicy policy = WaitPolicy::SpinThenPark)
+      : n(n), sequencer(policy) {}
+
+  /// @brief Executes the `foo` part of the sequence.
+  /// @param printFoo A callable object to be executed when it's `foo`'s turn.
+  void foo(function<void()> printFoo) {
+    for (int i = 0; i < this->n; i++) {
+      this->sequencer.waitFor(fooTurn);
+      printFoo();
+      this->sequencer.pass(barTurn);
+    }
+  }
+
+  /// @brief Executes the `bar` part of the sequence.
+  /// @param printBar A callable object to be executed when it's `bar`'s turn.
+  void bar(function<void()> printBar) {
+    for (int i = 0; i < this->n; i++) {
+      this->sequencer.waitFor(barTurn);
+      printBar();
+      this->sequencer.pass(fooTurn);
+    }
+  }
+
+ private:
+  /// @brief The turn during which `foo` runs.
+  static constexpr uint32_t fooTurn = 0;
+  /// @brief The turn during which `bar` runs.
+  static constexpr uint32_t barTurn = 1;
+
+  /// @brief The total number of times `foo` and `bar` should be called.
+  int n;
+  /// @brief The sequencer that decides whose turn it is.
+  TurnSequencer sequencer;
+};
+
+/// @class CoroutineFooBar
+/// @brief A `FooBar` whose two roles are coroutines instead of threads.
+///
+/// `foo` and `bar` await their turn on a `TurnBaton`, and each hand-off
+/// resumes the other role directly, with no lock and no kernel context
+/// switch. An instance costs two coroutine frames rather than two threads,
+/// and many instances can run on one `CoroutinePool`.
+class CoroutineFooBar {
+ public:
+  /// @brief Constructs a new CoroutineFooBar object.
+  /// @param n The number of alternating `foo` and `bar` calls.
+  CoroutineFooBar(int n) { this->n = n; }
+
+  /// @brief The `foo` role, created suspended.
+  /// @param printFoo A callable object to be executed when it's `foo`'s turn.
+  RoleTask foo(function<void()> printFoo) {
+    for (int i = 0; i < this->n; i++) {
+      co_await this->baton.turnOf(fooRole);
+      printFoo();
+      co_await this->baton.handOff(fooRole, barRole);
+    }
+  }
+
+  /// @brief The `bar` role, created suspended.
+  /// @param printBar A callable object to be executed when it's `bar`'s turn.
+  RoleTask bar(function<void()> printBar) {
+    for (int i = 0; i < this->n; i++) {
+      co_await this->baton.turnOf(barRole);
+      printBar();
+      co_await this->baton.handOff(barRole, fooRole);
+    }
+  }
+
+  /// @brief Runs both roles to completion as one job of `pool`.
+  ///
+  /// The object must stay alive until the job has finished, for example until
+  /// `pool.wait()` returns.
+  ///
+  /// @param pool The pool that runs the job.
+  /// @param printFoo A callable object to be executed when it's `foo`'s turn.
+  /// @param printBar A callable object to be executed when it's `bar`'s turn.
+  void runOn(CoroutinePool& pool, function<void()> printFoo,
+             function<void()> printBar) {
+    pool.post([this, printFoo, printBar]() {
+      RoleTask fooTask = this->foo(printFoo);
+      RoleTask barTask = this->bar(printBar);
+
+      fooTask.start();
+      barTask.start();
+    });
+  }
+
+ private:
+  /// @brief The role index of `foo`.
+  static constexpr size_t fooRole = 0;
+  /// @brief The role index of `bar`.
+  static constexpr size_t barRole = 1;
+
+  /// @brief The total number of times `foo` and `bar` should be called.
+  int n;
+  /// @brief The baton that decides whose turn it is.
+  TurnBaton<2> baton;
 };
\ No newline at end of file
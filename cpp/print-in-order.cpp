@@ -1,13 +1,33 @@
 /// @brief Defines the Foo class for sequential method execution.
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <span>
+#include <string>
+#include <thread>
 
+#include "ordering-support.hpp"
+
+using std::array;
+using std::atomic;
+using std::chrono::steady_clock;
 using std::condition_variable;
 using std::function;
 using std::mutex;
+using std::size_t;
+using std::span;
+using std::string;
+using std::thread;
+using std::uint32_t;
 using std::unique_lock;
+using std::unique_ptr;
 
 /// @brief A class that ensures three methods are executed in a specific order:
 /// first(), then second(), then third().
@@ -29,12 +49,24 @@ class Foo {
   /// turn counter, and notifies all waiting threads.
   /// @param printFirst A callable object that performs the action for the first step.
   void first(function<void()> printFirst) {
-    unique_lock lock(this->turnMtx);
-    this->turnCV.wait(lock, [this]() { return this->turn == 0; });
+    this->first<CallbackPlacement::UnderLock>(printFirst);
+  }
 
-    printFirst();
+  /// @brief Executes the first step with any callable, without wrapping it
+  /// in a `std::function`.
+  /// @tparam Placement Whether `printFirst` runs with the mutex held.
+  /// @tparam PrintFirst Any callable taking no arguments.
+  /// @param printFirst A callable object that performs the action for the first step.
+  template <CallbackPlacement Placement = CallbackPlacement::UnderLock,
+            typename PrintFirst>
+  void first(PrintFirst&& printFirst) {
+    unique_lock<mutex> lock(this->turnMtx);
+    this->awaitTurn(lock, 0);
+
+    this->invoke<Placement>(lock, 0, printFirst);
 
     this->turn += 1;
+    this->probe.handedOff();
     this->turnCV.notify_all();
   }
 
@@ -44,12 +76,24 @@ class Foo {
   /// turn counter, and notifies all waiting threads.
   /// @param printSecond A callable object that performs the action for the second step.
   void second(function<void()> printSecond) {
+    this->second<CallbackPlacement::UnderLock>(printSecond);
+  }
+
+  /// @brief Executes the second step with any callable, without wrapping it
+  /// in a `std::function`.
+  /// @tparam Placement Whether `printSecond` runs with the mutex held.
+  /// @tparam PrintSecond Any callable taking no arguments.
+  /// @param printSecond A callable object that performs the action for the second step.
+  template <CallbackPlacement Placement = CallbackPlacement::UnderLock,
+            typename PrintSecond>
+  void second(PrintSecond&& printSecond) {
     unique_lock<mutex> lock(this->turnMtx);
-    this->turnCV.wait(lock, [this]() { return this->turn == 1; });
+    this->awaitTurn(lock, 1);
 
-    printSecond();
+    this->invoke<Placement>(lock, 1, printSecond);
 
     this->turn += 1;
+    this->probe.handedOff();
     this->turnCV.notify_all();
   }
 
@@ -59,17 +103,228 @@ class Foo {
   /// concludes the sequence.
   /// @param printThird A callable object that performs the action for the third step.
   void third(function<void()> printThird) {
+    this->third<CallbackPlacement::UnderLock>(printThird);
+  }
+
+  /// @brief Executes the third step with any callable, without wrapping it
+  /// in a `std::function`.
+  /// @tparam Placement Whether `printThird` runs with the mutex held.
+  /// @tparam PrintThird Any callable taking no arguments.
+  /// @param printThird A callable object that performs the action for the third step.
+  template <CallbackPlacement Placement = CallbackPlacement::UnderLock,
+            typename PrintThird>
+  void third(PrintThird&& printThird) {
     unique_lock<mutex> lock(this->turnMtx);
-    this->turnCV.wait(lock, [this]() { return this->turn == 2; });
+    this->awaitTurn(lock, 2);
 
-    printThird();
+    this->invoke<Placement>(lock, 2, printThird);
   }
 
+#ifdef ORDERING_INSTRUMENTATION
+  /// @brief Returns the contention metrics of the three steps. Only call it
+  /// once every step has run.
+  array<RoleMetrics, 3> metrics() const { return this->probe.snapshot(); }
+
+  /// @brief Returns the contention metrics of the three steps as JSON.
+  string metricsJson() const { return metricsToJson(this->metrics()); }
+#endif
+
  private:
+  /// @brief Sleeps on the condition variable until `turn` reaches `step`,
+  /// recording each wake-up of that step.
+  void awaitTurn(unique_lock<mutex>& lock, uint8_t step) {
+    const steady_clock::time_point start = this->probe.now();
+
+    while (this->turn != step) {
+      this->turnCV.wait(lock);
+      this->probe.wokeUp(step, this->turn == step);
+    }
+
+    this->probe.gotTurn(step, start);
+  }
+
+  /// @brief Calls `callback`, with `lock` released around it when `Placement`
+  /// is `OutsideLock`.
+  template <CallbackPlacement Placement, typename Callback>
+  void invoke(unique_lock<mutex>& lock, uint8_t step, Callback& callback) {
+    const steady_clock::time_point start = this->probe.now();
+
+    if constexpr (Placement == CallbackPlacement::OutsideLock) {
+      lock.unlock();
+      callback();
+      lock.lock();
+    } else {
+      callback();
+    }
+
+    this->probe.calledBack(step, start);
+  }
+
   /// @brief An integer counter that indicates which step is currently active.
   uint8_t turn;
   /// @brief The condition variable used to block and unblock threads based on the `turn` counter.
   condition_variable turnCV;
   /// @brief The mutex used to protect the `turn` counter and the condition variable.
   mutex turnMtx;
+  /// @brief The contention metrics of each step, indexed by the `turn` it
+  /// waits for; empty unless `ORDERING_INSTRUMENTATION` is defined.
+  [[no_unique_address]] OrderingProbe<orderingInstrumentation, 3> probe{
+      {"first", "second", "third"}};
+};
+
+/// @brief The wait slot of one stage in an ordered sequence of stages.
+///
+/// Each slot sits on its own cache line and counts the permits its stage has
+/// been granted but not yet used. Threads only ever wait on the slot of their
+/// own stage.
+struct alignas(64) StageSlot {
+  /// @brief The number of unused permits of the stage.
+  atomic<uint32_t> permits = 0;
+};
+
+/// @brief Runs one stage of an ordered sequence once its turn has come.
+///
+/// The caller sleeps on the stage's own slot until the previous stage grants
+/// it a permit, runs `action`, then grants a permit to the following stage;
+/// after the last stage the permit wraps around to the first one, which starts
+/// the next round. Only the thread waiting on that following slot is woken.
+///
+/// @tparam Action A callable taking no arguments.
+/// @param slots The slots of every stage, the first one holding the initial
+/// permit.
+/// @param stage The index of the stage to run.
+/// @param action The work of the stage.
+template <typename Action>
+void runOrderedStage(span<StageSlot> slots, size_t stage, Action& action) {
+  atomic<uint32_t>& permits = slots[stage].permits;
+
+  while (permits.load(std::memory_order_acquire) == 0) {
+    permits.wait(0, std::memory_order_acquire);
+  }
+
+  permits.fetch_sub(1, std::memory_order_relaxed);
+
+  action();
+
+  atomic<uint32_t>& following = slots[(stage + 1) % slots.size()].permits;
+  following.fetch_add(1, std::memory_order_release);
+  following.notify_one();
+}
+
+/// @class OrderedStages
+/// @brief Generalizes `Foo` to `N` stages that run in order, round after round.
+///
+/// Unlike `Foo`, where every thread sleeps on the same condition variable and
+/// each hand-off wakes all of them, every stage waits on its own slot, so a
+/// hand-off wakes only the next stage. After stage `N - 1` runs, stage 0 may
+/// run again, so the object can be reused for any number of rounds. At most
+/// one thread may run a given stage at a time.
+///
+/// @tparam N The number of stages.
+template <size_t N>
+class OrderedStages {
+ public:
+  /// @brief Constructs a new OrderedStages object whose first round is ready
+  /// to start.
+  OrderedStages() { this->slots[0].permits = 1; }
+
+  /// @brief Executes a stage once every earlier stage of the round has run.
+  /// @param stage The index of the stage, in `[0, N)`.
+  /// @param action A callable object that performs the work of the stage.
+  void run(size_t stage, function<void()> action) {
+    runOrderedStage(span<StageSlot>(this->slots), stage, action);
+  }
+
+ private:
+  /// @brief The wait slot of every stage.
+  array<StageSlot, N> slots;
+};
+
+/// @class DynamicOrderedStages
+/// @brief The same ordering as `OrderedStages`, with the number of stages
+/// chosen at run time.
+class DynamicOrderedStages {
+ public:
+  /// @brief Constructs a new DynamicOrderedStages object whose first round is
+  /// ready to start.
+  /// @param stageCount The number of stages, at least 1.
+  explicit DynamicOrderedStages(size_t stageCount)
+      : stageCount(stageCount),
+        slots(std::make_unique<StageSlot[]>(stageCount)) {
+    this->slots[0].permits = 1;
+  }
+
+  /// @brief Executes a stage once every earlier stage of the round has run.
+  /// @param stage The index of the stage, in `[0, stageCount)`.
+  /// @param action A callable object that performs the work of the stage.
+  void run(size_t stage, function<void()> action) {
+    runOrderedStage(span<StageSlot>(this->slots.get(), this->stageCount),
+                    stage, action);
+  }
+
+  /// @brief Returns the number of stages.
+  size_t size() const { return this->stageCount; }
+
+ private:
+  /// @brief The number of stages.
+  size_t stageCount;
+  /// @brief The wait slot of every stage.
+  unique_ptr<StageSlot[]> slots;
+};
+
+/// @class CoroutineFoo
+/// @brief A `Foo` whose three steps are coroutines instead of threads.
+///
+/// Each step awaits its turn on a `TurnBaton` and the first two resume the
+/// next step directly when they finish, so the whole sequence runs on one
+/// thread without blocking.
+class CoroutineFoo {
+ public:
+  /// @brief The first step, created suspended.
+  /// @param printFirst A callable object that performs the action for the first step.
+  RoleTask first(function<void()> printFirst) {
+    co_await this->baton.turnOf(0);
+    printFirst();
+    co_await this->baton.handOff(0, 1);
+  }
+
+  /// @brief The second step, created suspended.
+  /// @param printSecond A callable object that performs the action for the second step.
+  RoleTask second(function<void()> printSecond) {
+    co_await this->baton.turnOf(1);
+    printSecond();
+    co_await this->baton.handOff(1, 2);
+  }
+
+  /// @brief The third and final step, created suspended.
+  /// @param printThird A callable object that performs the action for the third step.
+  RoleTask third(function<void()> printThird) {
+    co_await this->baton.turnOf(2);
+    printThird();
+  }
+
+  /// @brief Runs the three steps as one job of `pool`.
+  ///
+  /// The object must stay alive until the job has finished.
+  ///
+  /// @param pool The pool that runs the job.
+  /// @param printFirst The action of the first step.
+  /// @param printSecond The action of the second step.
+  /// @param printThird The action of the third step.
+  void runOn(CoroutinePool& pool, function<void()> printFirst,
+             function<void()> printSecond, function<void()> printThird) {
+    pool.post([this, printFirst, printSecond, printThird]() {
+      RoleTask firstTask = this->first(printFirst);
+      RoleTask secondTask = this->second(printSecond);
+      RoleTask thirdTask = this->third(printThird);
+
+      thirdTask.start();
+      secondTask.start();
+      firstTask.start();
+    });
+  }
+
+ private:
+  /// @brief The baton that decides which step may run.
+  TurnBaton<3> baton;
 };
\ No newline at end of file
@@ -1,12 +1,33 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <span>
+#include <string>
+#include <thread>
 
+#include "ordering-support.hpp"
+
+using std::array;
+using std::atomic;
+using std::chrono::steady_clock;
 using std::condition_variable;
 using std::function;
 using std::mutex;
+using std::size_t;
+using std::span;
+using std::string;
+using std::thread;
+using std::uint32_t;
 using std::unique_lock;
+using std::unique_ptr;
 
 /// @class ZeroEvenOdd
 /// @brief A class that ensures three methods (`zero`, `even`, and `odd`) are
@@ -34,14 +55,26 @@ class ZeroEvenOdd {
   /// to either the `odd` or `even` thread.
   /// @param printNumber A function that takes an `int` and prints it.
   void zero(function<void(int)> printNumber) {
+    this->zero<CallbackPlacement::UnderLock>(printNumber);
+  }
+
+  /// @brief Prints `0` through any callable, which is inlined into the loop
+  /// instead of being called through a `std::function`.
+  /// @tparam Placement Whether `printNumber` runs with the mutex held.
+  /// @tparam PrintNumber Any callable taking an `int`.
+  /// @param printNumber A function that takes an `int` and prints it.
+  template <CallbackPlacement Placement = CallbackPlacement::UnderLock,
+            typename PrintNumber>
+  void zero(PrintNumber&& printNumber) {
     for (int i = 0; i < this->n; i++) {
       unique_lock lock(this->turnMutex);
-      turnCV.wait(lock, [this]() { return this->isZeroTime; });
+      this->awaitTurn(lock, zeroRole, [this]() { return this->isZeroTime; });
 
-      printNumber(0);
+      this->invoke<Placement>(lock, zeroRole, printNumber, 0);
 
       this->isZeroTime = false;
 
+      this->probe.handedOff();
       this->turnCV.notify_all();
     }
   }
@@ -53,16 +86,28 @@ class ZeroEvenOdd {
   /// control back to the `zero` thread.
   /// @param printNumber A function that takes an `int` and prints it.
   void even(function<void(int)> printNumber) {
+    this->even<CallbackPlacement::UnderLock>(printNumber);
+  }
+
+  /// @brief Prints even numbers through any callable.
+  /// @tparam Placement Whether `printNumber` runs with the mutex held.
+  /// @tparam PrintNumber Any callable taking an `int`.
+  /// @param printNumber A function that takes an `int` and prints it.
+  template <CallbackPlacement Placement = CallbackPlacement::UnderLock,
+            typename PrintNumber>
+  void even(PrintNumber&& printNumber) {
     for (int i = 2; i <= this->n; i += 2) {
       unique_lock lock(this->turnMutex);
-      turnCV.wait(lock,
-                  [this]() { return !this->isZeroTime && this->isEvenTime; });
+      this->awaitTurn(lock, evenRole, [this]() {
+        return !this->isZeroTime && this->isEvenTime;
+      });
 
-      printNumber(i);
+      this->invoke<Placement>(lock, evenRole, printNumber, i);
 
       this->isEvenTime = false;
       this->isZeroTime = true;
 
+      this->probe.handedOff();
       this->turnCV.notify_all();
     }
   }
@@ -74,21 +119,79 @@ class ZeroEvenOdd {
   /// control to the `even` thread for the next cycle.
   /// @param printNumber A function that takes an `int` and prints it.
   void odd(function<void(int)> printNumber) {
+    this->odd<CallbackPlacement::UnderLock>(printNumber);
+  }
+
+  /// @brief Prints odd numbers through any callable.
+  /// @tparam Placement Whether `printNumber` runs with the mutex held.
+  /// @tparam PrintNumber Any callable taking an `int`.
+  /// @param printNumber A function that takes an `int` and prints it.
+  template <CallbackPlacement Placement = CallbackPlacement::UnderLock,
+            typename PrintNumber>
+  void odd(PrintNumber&& printNumber) {
     for (int i = 1; i <= this->n; i += 2) {
       unique_lock lock(this->turnMutex);
-      turnCV.wait(lock,
-                  [this]() { return !this->isZeroTime && !this->isEvenTime; });
+      this->awaitTurn(lock, oddRole, [this]() {
+        return !this->isZeroTime && !this->isEvenTime;
+      });
 
-      printNumber(i);
+      this->invoke<Placement>(lock, oddRole, printNumber, i);
 
       this->isEvenTime = true;
       this->isZeroTime = true;
 
+      this->probe.handedOff();
       this->turnCV.notify_all();
     }
   }
 
+#ifdef ORDERING_INSTRUMENTATION
+  /// @brief Returns the contention metrics of `zero`, `even` and `odd`, in
+  /// that order. Only call it once the three threads are done.
+  array<RoleMetrics, 3> metrics() const { return this->probe.snapshot(); }
+
+  /// @brief Returns the contention metrics of the three roles as JSON.
+  string metricsJson() const { return metricsToJson(this->metrics()); }
+#endif
+
  private:
+  /// @brief The index of each role in `probe`.
+  static constexpr size_t zeroRole = 0;
+  static constexpr size_t evenRole = 1;
+  static constexpr size_t oddRole = 2;
+
+  /// @brief Waits on `turnCV` until `isTurn` holds, telling the probe about
+  /// every wake-up of `role`.
+  template <typename Predicate>
+  void awaitTurn(unique_lock<mutex>& lock, size_t role, Predicate isTurn) {
+    const steady_clock::time_point start = this->probe.now();
+
+    while (!isTurn()) {
+      this->turnCV.wait(lock);
+      this->probe.wokeUp(role, isTurn());
+    }
+
+    this->probe.gotTurn(role, start);
+  }
+
+  /// @brief Prints `number` through `printNumber`, releasing `lock` around
+  /// the call when `Placement` is `OutsideLock`.
+  template <CallbackPlacement Placement, typename PrintNumber>
+  void invoke(unique_lock<mutex>& lock, size_t role, PrintNumber& printNumber,
+              int number) {
+    const steady_clock::time_point start = this->probe.now();
+
+    if constexpr (Placement == CallbackPlacement::OutsideLock) {
+      lock.unlock();
+      printNumber(number);
+      lock.lock();
+    } else {
+      printNumber(number);
+    }
+
+    this->probe.calledBack(role, start);
+  }
+
   /// @brief The total number of iterations for the sequence.
   int n;
   /// @brief A boolean flag that indicates if it's the `zero` method's turn.
@@ -101,4 +204,364 @@ class ZeroEvenOdd {
   /// @brief The condition variable used to block and unblock threads based on
   /// whose turn it is.
   condition_variable turnCV;
+  /// @brief The contention metrics of every role; empty unless
+  /// `ORDERING_INSTRUMENTATION` is defined.
+  [[no_unique_address]] OrderingProbe<orderingInstrumentation, 3> probe{
+      {"zero", "even", "odd"}};
+};
+
+/// @class TargetedZeroEvenOdd
+/// @brief A `ZeroEvenOdd` in which every hand-off wakes exactly one thread.
+///
+/// Each role sleeps on its own condition variable, and the thread that ends a
+/// turn notifies only the role whose turn comes next. In `ZeroEvenOdd`, every
+/// `notify_all` also wakes the third thread, which re-checks its predicate and
+/// goes back to sleep. The class counts, per role, how often the thread
+/// blocked and how many of its wake-ups found the turn still taken.
+class TargetedZeroEvenOdd {
+ public:
+  /// @brief Wake-up counters of one role.
+  struct WakeStats {
+    /// @brief How many times the thread went to sleep waiting for its turn.
+    /// Each of them costs at least one context switch.
+    size_t blockingWaits = 0;
+    /// @brief How many times the thread woke up from such a sleep.
+    size_t wakeUps = 0;
+    /// @brief How many of those wake-ups found that the turn was still not
+    /// the thread's.
+    size_t spuriousWakeUps = 0;
+  };
+
+  /// @brief Constructs a new TargetedZeroEvenOdd object.
+  /// @param n The total number of iterations for the sequence.
+  TargetedZeroEvenOdd(int n) {
+    this->n = n;
+    this->turn = Turn::Zero;
+  }
+
+  /// @brief Prints `0` before every number, then wakes the role that prints
+  /// that number.
+  /// @param printNumber A function that takes an `int` and prints it.
+  void zero(function<void(int)> printNumber) {
+    for (int i = 1; i <= this->n; i++) {
+      unique_lock lock(this->turnMutex);
+      this->await(lock, Turn::Zero, this->zeroCV, this->zeroStats);
+
+      printNumber(0);
+
+      if (i % 2 == 0) {
+        this->turn = Turn::Even;
+        this->evenCV.notify_one();
+      } else {
+        this->turn = Turn::Odd;
+        this->oddCV.notify_one();
+      }
+    }
+  }
+
+  /// @brief Prints even numbers, waking the `zero` role after each one.
+  /// @param printNumber A function that takes an `int` and prints it.
+  void even(function<void(int)> printNumber) {
+    for (int i = 2; i <= this->n; i += 2) {
+      unique_lock lock(this->turnMutex);
+      this->await(lock, Turn::Even, this->evenCV, this->evenStats);
+
+      printNumber(i);
+
+      this->turn = Turn::Zero;
+      this->zeroCV.notify_one();
+    }
+  }
+
+  /// @brief Prints odd numbers, waking the `zero` role after each one.
+  /// @param printNumber A function that takes an `int` and prints it.
+  void odd(function<void(int)> printNumber) {
+    for (int i = 1; i <= this->n; i += 2) {
+      unique_lock lock(this->turnMutex);
+      this->await(lock, Turn::Odd, this->oddCV, this->oddStats);
+
+      printNumber(i);
+
+      this->turn = Turn::Zero;
+      this->zeroCV.notify_one();
+    }
+  }
+
+  /// @brief Returns the counters of the `zero` role.
+  WakeStats zeroWakeStats() const { return this->zeroStats; }
+  /// @brief Returns the counters of the `even` role.
+  WakeStats evenWakeStats() const { return this->evenStats; }
+  /// @brief Returns the counters of the `odd` role.
+  WakeStats oddWakeStats() const { return this->oddStats; }
+
+ private:
+  /// @brief The role allowed to print next.
+  enum class Turn { Zero, Odd, Even };
+
+  /// @brief Sleeps on `cv` until the turn is `expected`, updating `stats`.
+  void await(unique_lock<mutex>& lock, Turn expected, condition_variable& cv,
+             WakeStats& stats) {
+    if (this->turn == expected) {
+      return;
+    }
+
+    stats.blockingWaits++;
+
+    while (true) {
+      cv.wait(lock);
+      stats.wakeUps++;
+
+      if (this->turn == expected) {
+        return;
+      }
+
+      stats.spuriousWakeUps++;
+    }
+  }
+
+  /// @brief The total number of iterations for the sequence.
+  int n;
+  /// @brief The role allowed to print next.
+  Turn turn;
+  /// @brief The mutex used to protect the turn and the counters.
+  mutex turnMutex;
+  /// @brief The condition variable the `zero` role sleeps on.
+  condition_variable zeroCV;
+  /// @brief The condition variable the `even` role sleeps on.
+  condition_variable evenCV;
+  /// @brief The condition variable the `odd` role sleeps on.
+  condition_variable oddCV;
+  /// @brief The counters of the `zero` role.
+  WakeStats zeroStats;
+  /// @brief The counters of the `even` role.
+  WakeStats evenStats;
+  /// @brief The counters of the `odd` role.
+  WakeStats oddStats;
+};
+
+/// @class BatchedZeroEvenOdd
+/// @brief A high-throughput `ZeroEvenOdd` that writes the sequence into a
+/// shared ring of batches instead of handing off once per number.
+///
+/// The sequence `0 1 0 2 0 3 ...` is split into fixed-size batches. Position
+/// `p` holds `0` when `p` is even and `(p + 1) / 2` otherwise, so every worker
+/// knows its own slots in advance: `zero` fills the even positions, `odd` and
+/// `even` fill the odd positions whose value has their parity. The three
+/// workers fill a batch concurrently, without locks, and the last one to
+/// finish publishes it. A single consumer reads the published batches in
+/// order and frees their ring slots. The threads synchronize once per batch
+/// instead of once per number.
+class BatchedZeroEvenOdd {
+ public:
+  /// @brief Constructs a new BatchedZeroEvenOdd object.
+  /// @param n The total number of iterations for the sequence.
+  /// @param batchSize The number of positions in each batch, at least 1.
+  /// @param ringBatches The number of batches the ring holds, at least 1.
+  BatchedZeroEvenOdd(int n, size_t batchSize = 4096, size_t ringBatches = 4)
+      : length(2 * static_cast<size_t>(n)),
+        batchSize(batchSize),
+        ringBatches(ringBatches),
+        batchCount((this->length + batchSize - 1) / batchSize),
+        buffer(std::make_unique<int[]>(batchSize * ringBatches)),
+        slots(std::make_unique<RingSlot[]>(ringBatches)) {}
+
+  /// @brief Writes every `0` of the sequence.
+  void zero() {
+    this->produce(0, [](size_t) { return 0; });
+  }
+
+  /// @brief Writes every even number of the sequence.
+  void even() {
+    this->produce(3, [](size_t position) {
+      return static_cast<int>((position + 1) / 2);
+    });
+  }
+
+  /// @brief Writes every odd number of the sequence.
+  void odd() {
+    this->produce(1, [](size_t position) {
+      return static_cast<int>((position + 1) / 2);
+    });
+  }
+
+  /// @brief Reads the whole sequence, one completed batch at a time.
+  /// @tparam Sink A callable taking a `span<const int>`.
+  /// @param sink The consumer of the batches, called in order. The view it
+  /// receives is only valid until it returns.
+  template <typename Sink>
+  void consume(Sink&& sink) {
+    for (size_t batch = 0; batch < this->batchCount; batch++) {
+      size_t ready = this->completed.load(std::memory_order_acquire);
+
+      while (ready <= batch) {
+        this->completed.wait(ready, std::memory_order_acquire);
+        ready = this->completed.load(std::memory_order_acquire);
+      }
+
+      const size_t slot = batch % this->ringBatches;
+      const size_t begin = batch * this->batchSize;
+      const size_t size = std::min(this->batchSize, this->length - begin);
+
+      sink(span<const int>(this->buffer.get() + slot * this->batchSize, size));
+
+      this->slots[slot].finishedRoles.store(0, std::memory_order_relaxed);
+      this->consumed.store(batch + 1, std::memory_order_release);
+      this->consumed.notify_all();
+    }
+  }
+
+ private:
+  /// @brief The number of workers that fill every batch.
+  static constexpr uint32_t roleCount = 3;
+
+  /// @brief The completion counter of one ring slot, on its own cache line.
+  struct alignas(64) RingSlot {
+    /// @brief How many workers have filled their part of the batch.
+    atomic<uint32_t> finishedRoles = 0;
+  };
+
+  /// @brief Fills this worker's positions of every batch.
+  ///
+  /// A worker owns the positions `p` where `p % 4` equals `phase`, or every
+  /// even position when `phase` is 0.
+  ///
+  /// @param phase 0 for `zero`, 1 for `odd` and 3 for `even`.
+  /// @param valueAt Returns the value of a position owned by this worker.
+  template <typename ValueAt>
+  void produce(size_t phase, ValueAt valueAt) {
+    const size_t stride = phase == 0 ? 2 : 4;
+
+    for (size_t batch = 0; batch < this->batchCount; batch++) {
+      this->waitForSlot(batch);
+
+      const size_t begin = batch * this->batchSize;
+      const size_t end = std::min(begin + this->batchSize, this->length);
+      int* out =
+          this->buffer.get() + (batch % this->ringBatches) * this->batchSize;
+
+      size_t position = begin + (phase + stride - begin % stride) % stride;
+
+      for (; position < end; position += stride) {
+        out[position - begin] = valueAt(position);
+      }
+
+      this->finish(batch);
+    }
+  }
+
+  /// @brief Blocks until the consumer has freed the ring slot of `batch`.
+  void waitForSlot(size_t batch) {
+    size_t freed = this->consumed.load(std::memory_order_acquire);
+
+    while (batch >= freed + this->ringBatches) {
+      this->consumed.wait(freed, std::memory_order_acquire);
+      freed = this->consumed.load(std::memory_order_acquire);
+    }
+  }
+
+  /// @brief Records that this worker has filled its part of `batch`, and
+  /// publishes the batch if it was the last one to do so.
+  ///
+  /// Every worker fills its batches in order, so batches are always completed
+  /// in order as well.
+  void finish(size_t batch) {
+    RingSlot& slot = this->slots[batch % this->ringBatches];
+
+    if (slot.finishedRoles.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+        roleCount) {
+      this->completed.store(batch + 1, std::memory_order_release);
+      this->completed.notify_one();
+    }
+  }
+
+  /// @brief The number of positions in the whole sequence.
+  size_t length;
+  /// @brief The number of positions in each batch.
+  size_t batchSize;
+  /// @brief The number of batches the ring holds.
+  size_t ringBatches;
+  /// @brief The number of batches in the whole sequence.
+  size_t batchCount;
+  /// @brief The ring of batches.
+  unique_ptr<int[]> buffer;
+  /// @brief The completion counter of every ring slot.
+  unique_ptr<RingSlot[]> slots;
+  /// @brief The number of batches published so far.
+  alignas(64) atomic<size_t> completed = 0;
+  /// @brief The number of batches consumed so far.
+  alignas(64) atomic<size_t> consumed = 0;
+};
+
+/// @class CoroutineZeroEvenOdd
+/// @brief A `ZeroEvenOdd` whose three roles are coroutines instead of threads.
+///
+/// `zero` hands the turn to `odd` or `even` depending on the next number, and
+/// both hand it back to `zero`, each time resuming the successor directly.
+class CoroutineZeroEvenOdd {
+ public:
+  /// @brief Constructs a new CoroutineZeroEvenOdd object.
+  /// @param n The total number of iterations for the sequence.
+  CoroutineZeroEvenOdd(int n) { this->n = n; }
+
+  /// @brief The `zero` role, created suspended.
+  /// @param printNumber A function that takes an `int` and prints it.
+  RoleTask zero(function<void(int)> printNumber) {
+    for (int i = 1; i <= this->n; i++) {
+      co_await this->baton.turnOf(zeroRole);
+      printNumber(0);
+      co_await this->baton.handOff(zeroRole, i % 2 == 0 ? evenRole : oddRole);
+    }
+  }
+
+  /// @brief The `even` role, created suspended.
+  /// @param printNumber A function that takes an `int` and prints it.
+  RoleTask even(function<void(int)> printNumber) {
+    for (int i = 2; i <= this->n; i += 2) {
+      co_await this->baton.turnOf(evenRole);
+      printNumber(i);
+      co_await this->baton.handOff(evenRole, zeroRole);
+    }
+  }
+
+  /// @brief The `odd` role, created suspended.
+  /// @param printNumber A function that takes an `int` and prints it.
+  RoleTask odd(function<void(int)> printNumber) {
+    for (int i = 1; i <= this->n; i += 2) {
+      co_await this->baton.turnOf(oddRole);
+      printNumber(i);
+      co_await this->baton.handOff(oddRole, zeroRole);
+    }
+  }
+
+  /// @brief Runs the three roles to completion as one job of `pool`.
+  ///
+  /// The object must stay alive until the job has finished.
+  ///
+  /// @param pool The pool that runs the job.
+  /// @param printNumber A function that takes an `int` and prints it, shared
+  /// by the three roles.
+  void runOn(CoroutinePool& pool, function<void(int)> printNumber) {
+    pool.post([this, printNumber]() {
+      RoleTask zeroTask = this->zero(printNumber);
+      RoleTask evenTask = this->even(printNumber);
+      RoleTask oddTask = this->odd(printNumber);
+
+      evenTask.start();
+      oddTask.start();
+      zeroTask.start();
+    });
+  }
+
+ private:
+  /// @brief The role index of `zero`.
+  static constexpr size_t zeroRole = 0;
+  /// @brief The role index of `odd`.
+  static constexpr size_t oddRole = 1;
+  /// @brief The role index of `even`.
+  static constexpr size_t evenRole = 2;
+
+  /// @brief The total number of iterations for the sequence.
+  int n;
+  /// @brief The baton that decides whose turn it is.
+  TurnBaton<3> baton;
 };
\ No newline at end of file